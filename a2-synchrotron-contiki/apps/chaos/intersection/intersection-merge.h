@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017 Beshr Al Nahas and Olaf Landsiedel.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************/
+/**
+ * \file
+ *         Merge callback of the intersection application.
+ *         Included by merge-commit.c (MERGE_COMMIT_CALLBACK_HEADER) so it
+ *         is inlined into the slot processing.
+ * \author
+ *         Patrick Rathje <mail@patrickrathje.de>
+ */
+
+#ifndef INTERSECTION_MERGE_H_
+#define INTERSECTION_MERGE_H_
+
+#include "merge-commit.h"
+
+static inline void
+merge_commit_merge_callback(merge_commit_t* rx_mc, merge_commit_t* tx_mc)
+{
+  uint8_t i;
+  merge_commit_value_t *rv = &rx_mc->value;
+  merge_commit_value_t *tv = &tx_mc->value;
+
+  // cache the reservations for faster access!
+  // add the zero, which is no reservation
+  uint16_t reservation_priorities[MAX_NODE_COUNT+1];
+
+  // the first one has no priority at all
+  reservation_priorities[0] = 0;
+
+  for(i = 0; i < MAX_NODE_COUNT; ++i) {
+    // we can use bitwise or here since either one of them is 0 or both have the same value...
+    uint16_t merged_priority = rv->priorities[i] | tv->priorities[i];
+
+    // save the merged priority directly in our value
+    tv->priorities[i] = merged_priority;
+    reservation_priorities[i+1] = merged_priority;
+  }
+
+  // every tile only depends on its own entries, so we can merge in place
+  for(i = 0; i < NUM_TILES; ++i) {
+
+    // we compute the maximum of the received and our own grid
+    uint8_t a = rv->tile_reservations[i];
+    uint8_t b = tv->tile_reservations[i];
+
+    if (a == b) {
+      continue;
+    }
+
+    uint16_t pa = reservation_priorities[a];
+    uint16_t pb = reservation_priorities[b];
+
+    // use the id as a tie-breaker, higher ids first
+    if (pa > pb || (pa == pb && a > b)) {
+      tv->tile_reservations[i] = a;
+    }
+  }
+}
+
+#endif /* INTERSECTION_MERGE_H_ */
@@ -45,11 +45,13 @@
 #include <stdlib.h>
 
 #include "chaos-control.h"
+#include "chaos-random-generator.h"
 #include "node.h"
 
 
 #include "merge-commit.h"
 #include "random.h"
+#include "intersection-priority.h"
 
 
 uint8_t wanted_channel;
@@ -191,6 +193,8 @@ static int path_available(merge_commit_value_t *plan, path_t* path, int node_id)
 
 
 static uint16_t own_priority = 0;
+static uint8_t own_class = INTERSECTION_CLASS_DEFAULT;
+static uint16_t reservation_round = 0;
 
 
 static path_t own_reservation;
@@ -236,15 +240,14 @@ static void update_reservation() {
     if (!WAIT_FOR_FREE_PATH || path_available(&mc_last_commited_value, &own_reservation, chaos_node_index+1)) {
       reserve_path(&mc_value, &own_reservation, chaos_node_index+1);
 
-      // initialized default value for the priority if none is set
+      // a new reservation starts aging now
       if (!own_priority) {
-        own_priority = 0xFFFF-arrival_round; // 0 is no reservation, 0xFFFF is for the ones in the intersection
-        if (own_priority == 0xFFFF) {
-          own_priority = 0xFFFF-1;
-        }
-        if (own_priority == 0) {
-          own_priority = 1;
-        }
+        reservation_round = arrival_round;
+      }
+
+      // 0 is no reservation, 0xFFFF is for the ones in the intersection
+      if (own_priority != 0xFFFF) {
+        own_priority = INTERSECTION_PRIORITY(own_class, (uint16_t)(arrival_round-reservation_round));
       }
 
       mc_value.priorities[chaos_node_index] = own_priority;
@@ -415,8 +418,13 @@ PROCESS_THREAD(comm_process, ev, data)
         // we directly change the channel
         chaos_multichannel_set_current_channel(wanted_channel);
       }
+    } else if (msg_id == 'P' && msg_size == 1) {
+      own_class = msg_data[0];
+      update_reservation();
     } else if (msg_id == 'R') {
       // copy that reservation to our own
+      // for a platoon head this is the union of the tiles of all members,
+      // the followers do not join the network and are covered by our entry
 
       own_reservation.size = msg_size;
       memcpy(own_reservation.tiles, msg_data, msg_size);
@@ -456,7 +464,6 @@ PROCESS_THREAD(comm_process, ev, data)
   PROCESS_END();
 }
 
-unsigned short rseed = 0; /* Will be set to a value by cooja! */
 PROCESS(main_process, "Main intersection process");
 AUTOSTART_PROCESSES(&main_process);
 PROCESS_THREAD(main_process, ev, data)
@@ -514,64 +521,3 @@ static void mc_round_begin(const uint16_t round_count, const uint8_t id){
   mc_round_count_local = round_count;
   process_poll(&mc_process);
 }
-
-
-void merge_commit_merge_callback(merge_commit_t* rx_mc, merge_commit_t* tx_mc) {
-
- /* static int time_diff = 0;
-  int start = RTIMER_NOW(); */
-
-  static int i = 0;
-  merge_commit_value_t new;
-  memset(&new, 0, sizeof(merge_commit_value_t));
-
-  // cache the reservations for faster access!
-  // add the zero, which is no reservation
-  uint16_t reservation_priorities[MAX_NODE_COUNT+1];
-
-  // the first one has no priority at all
-  reservation_priorities[0] = 0;
-
-  for(i = 0; i < MAX_NODE_COUNT; ++i) {
-    // we can use bitwise or here since either one of them is 0 or both have the same value...
-    uint16_t merged_priority = rx_mc->value.priorities[i] | tx_mc->value.priorities[i];
-
-    // save the merged priority in the merged commit value
-    new.priorities[i] = merged_priority;
-    reservation_priorities[i+1] = merged_priority;
-  }
-
-  merge_commit_value_t *rv = &rx_mc->value;
-  merge_commit_value_t *tv = &tx_mc->value;
-
-  for(i = 0; i < NUM_TILES; ++i) {
-
-    // we compute the maximum of the received and our own grid
-    uint16_t a = rv->tile_reservations[i];
-    uint16_t b = tv->tile_reservations[i];
-    uint16_t res;
-
-    if (reservation_priorities[a] == reservation_priorities[b]) {
-      // use the id as a tie-breaker, higher ids first
-      if (b >= a) {
-        res = b;
-      } else {
-        res = a;
-      }
-    } else if (reservation_priorities[a] > reservation_priorities[b]) {
-      res = a;
-    } else {
-      res = b;
-    }
-
-    new.tile_reservations[i] = res;
-  }
-  // now copy the generated reservations
-  memcpy(&tx_mc->value, &new, sizeof(merge_commit_value_t));
-
-  /*int endTime = RTIMER_NOW();
-  if (time_diff < endTime-start) {
-    printf("New Merge-Commit diff %d ms\n", 1000*time_diff/RTIMER_SECOND);
-    time_diff = endTime-start;
-  }*/
-}
\ No newline at end of file
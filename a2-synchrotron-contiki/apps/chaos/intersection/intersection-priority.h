@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017 Beshr Al Nahas and Olaf Landsiedel.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************/
+/**
+ * \file
+ *         Reservation priority policy of the intersection application.
+ *         A priority is (level << 14) | age: the level comes from the
+ *         vehicle class, the age counts the rounds since the reservation
+ *         was made. Older requests win within a level, so class 0 alone
+ *         behaves like the former arrival order. Requests that waited
+ *         INTERSECTION_MAX_WAIT_ROUNDS are raised above everything but
+ *         emergency vehicles, which bounds the wait on every approach.
+ *         0 (no reservation) and 0xFFFF (in the intersection) are never
+ *         returned.
+ *
+ *         Define INTERSECTION_PRIORITY(class, waited_rounds) in the
+ *         project-conf.h to plug in another policy.
+ * \author
+ *         Patrick Rathje <mail@patrickrathje.de>
+ */
+
+#ifndef INTERSECTION_PRIORITY_H_
+#define INTERSECTION_PRIORITY_H_
+
+#include <stdint.h>
+
+/* Vehicle classes, set by the plugin with the 'P' message */
+#define INTERSECTION_CLASS_DEFAULT 0
+#define INTERSECTION_CLASS_PUBLIC_TRANSPORT 1
+#define INTERSECTION_CLASS_EMERGENCY 2
+
+#ifndef INTERSECTION_MAX_WAIT_ROUNDS
+#define INTERSECTION_MAX_WAIT_ROUNDS 15
+#endif
+
+#define INTERSECTION_PRIORITY_LEVEL_SHIFT 14
+#define INTERSECTION_PRIORITY_MAX_AGE ((1 << INTERSECTION_PRIORITY_LEVEL_SHIFT) - 2)
+
+#define INTERSECTION_LEVEL_DEFAULT 0
+#define INTERSECTION_LEVEL_PUBLIC_TRANSPORT 1
+#define INTERSECTION_LEVEL_STARVING 2
+#define INTERSECTION_LEVEL_EMERGENCY 3
+
+static inline uint16_t
+intersection_default_priority(uint8_t vehicle_class, uint16_t waited_rounds)
+{
+  uint16_t level;
+
+  if (vehicle_class == INTERSECTION_CLASS_EMERGENCY) {
+    level = INTERSECTION_LEVEL_EMERGENCY;
+  } else if (waited_rounds >= INTERSECTION_MAX_WAIT_ROUNDS) {
+    level = INTERSECTION_LEVEL_STARVING;
+  } else if (vehicle_class == INTERSECTION_CLASS_PUBLIC_TRANSPORT) {
+    level = INTERSECTION_LEVEL_PUBLIC_TRANSPORT;
+  } else {
+    level = INTERSECTION_LEVEL_DEFAULT;
+  }
+
+  // +1 so that a fresh request is never 0, the cap keeps the top level below 0xFFFF
+  if (waited_rounds > INTERSECTION_PRIORITY_MAX_AGE - 1) {
+    waited_rounds = INTERSECTION_PRIORITY_MAX_AGE - 1;
+  }
+  return (level << INTERSECTION_PRIORITY_LEVEL_SHIFT) | (waited_rounds + 1);
+}
+
+#ifndef INTERSECTION_PRIORITY
+#define INTERSECTION_PRIORITY(vehicle_class, waited_rounds) intersection_default_priority(vehicle_class, waited_rounds)
+#endif
+
+#endif /* INTERSECTION_PRIORITY_H_ */
@@ -71,6 +71,8 @@
 #define CHAOS_DYNAMIC_INITIATOR 1
 
 #define MERGE_COMMIT_ROUND_MAX_SLOTS (200)
+/* Not lowered yet: the worst-case merge of the inlined tile callback has
+ * not been measured on the MSP430 */
 #define MERGE_COMMIT_SLOT_LEN_MSEC 6
 
 
@@ -102,9 +104,16 @@
 
 #define JOIN_STRESS_TEST (_param_join == 2)
 
-//remember to disable logs
+/* binary slot trace (make trace=1), cheap enough to keep on in performance runs.
+ * The VANET plugin logs it as chaos-trace-<id>.csv */
+#ifndef CHAOS_LOG_TRACE
+#define CHAOS_LOG_TRACE 0
+#endif
+#define CHAOS_LOG_TRACE_PREFIX "#VANET CHAOS-TRACE"
+
+//remember to disable (text) logs
 #undef WITH_CHAOS_LOG
-#define WITH_CHAOS_LOG 0
+#define WITH_CHAOS_LOG CHAOS_LOG_TRACE
 //don't disable PRINTF if logs are enabled ;)
 #undef CHAOS_DEBUG_PRINTF
 #define CHAOS_DEBUG_PRINTF 1
@@ -240,6 +249,8 @@
 #define NUM_TILES (TILES_WIDTH * TILES_HEIGHT)
 
 #define MERGE_COMMIT_VALUE_STRUCT_CONTENT uint16_t priorities[MAX_NODE_COUNT]; uint8_t tile_reservations[NUM_TILES];
+/* inline the tile merge into the merge-commit slot processing */
+#define MERGE_COMMIT_CALLBACK_HEADER "intersection-merge.h"
 #define SERIAL_LINE_CONF_BUFSIZE 256
 
 
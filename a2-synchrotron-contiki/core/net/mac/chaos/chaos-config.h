@@ -44,7 +44,12 @@
 
 #include "contiki.h"
 
+#if CONTIKI_TARGET_COOJA
+/* the native Cooja radio has no security engine */
+#define CHAOS_HW_SECURITY 0
+#else
 #define CHAOS_HW_SECURITY ((LLSEC802154_SECURITY_LEVEL > 0) && (LLSEC802154_SECURITY_LEVEL <= 7))
+#endif
 
 //#define ENABLE_COOJA_DEBUG 0
 //#include "dev/cooja-debug.h"
@@ -80,7 +85,11 @@
 #define RTIMER_LATENCY ((RTIMER_SECOND/1000)) /* rtimer ticks delay of rtimer wakeup from scheduled time */
 #define RTIMER_LATENCY_INITIATOR RTIMER_LATENCY
 #define SFD_DETECTION_TIME_MIN (US_TO_DCOTICKS(192+64)) /* radio turn around time? */
+#if CONTIKI_TARGET_COOJA
+#define RX_GUARD_TIME (2) /* rtimer ticks per slot, 1 ms each */
+#else
 #define RX_GUARD_TIME (10) /* rtimer ticks per slot */
+#endif
 #define ROUND_GUARD_TIME ((RTIMER_SECOND/1000))
 
 /* start a round every CHAOS_INTERVAL seconds
@@ -51,7 +51,9 @@
 
 #if WITH_CHAOS_LOG
 
+#ifndef CHAOS_MAX_LOGS
 #define CHAOS_MAX_LOGS 256
+#endif
 #if (CHAOS_MAX_LOGS & (CHAOS_MAX_LOGS-1)) != 0
 #error CHAOS_MAX_LOGS must be power of two
 #endif
@@ -65,6 +67,89 @@ static chaos_log_t log_array[CHAOS_MAX_LOGS];
 static int log_dropped = 0;
 
 
+#if CHAOS_LOG_TRACE
+/* Record layout, all fields big endian:
+ * round(2) slot(2) channel(1) state<<4|rx_status(1) sfd_delta(4) src_id(2) flag_progress(1) */
+#define CHAOS_LOG_TRACE_RECORD_LEN 13
+/* Line header: 'T' node_id(2) dropped(2), followed by up to
+ * CHAOS_LOG_TRACE_RECORDS_PER_LINE records */
+#define CHAOS_LOG_TRACE_VERSION 'T'
+
+/* Same escaping as the VANET serial messages: keep \n, \r and \0 out of the line */
+static void
+trace_put(uint8_t c)
+{
+  if(c == '\n') {
+    putchar(0x11);
+    putchar(0x12);
+  } else if(c == '\r') {
+    putchar(0x11);
+    putchar(0x13);
+  } else if(c == '\0') {
+    putchar(0x11);
+    putchar(0x14);
+  } else if(c == 0x11) {
+    putchar(0x11);
+    putchar(0x11);
+  } else {
+    putchar(c);
+  }
+}
+
+static void
+trace_put16(uint16_t v)
+{
+  trace_put(v >> 8);
+  trace_put(v & 0xff);
+}
+
+static void
+trace_put32(uint32_t v)
+{
+  trace_put16(v >> 16);
+  trace_put16(v & 0xffff);
+}
+
+/* Process pending log messages: binary trace, no formatting */
+void
+chaos_log_process_pending()
+{
+  int16_t log_index;
+  uint8_t in_line = 0;
+
+  while((log_index = ringbufindex_peek_get(&log_ringbuf)) != -1) {
+    chaos_log_t *log = &log_array[log_index];
+    if(log->logtype == chaos_log_txrx) {
+      if(in_line == 0) {
+        printf(CHAOS_LOG_TRACE_PREFIX);
+        trace_put(CHAOS_LOG_TRACE_VERSION);
+        trace_put16(node_id);
+        trace_put16(log_dropped);
+      }
+      trace_put16(log->round_number);
+      trace_put16(log->slot_number);
+      trace_put(log->channel);
+      trace_put((log->txrx.state << 4) | (log->txrx.rx_status & 0xf));
+      trace_put32((uint32_t)log->txrx.t_sfd_delta);
+#if CHAOS_USE_SRC_ID
+      trace_put16(log->txrx.src_node_id);
+#else
+      trace_put16(0);
+#endif
+      trace_put(log->txrx.flag_progress);
+      if(++in_line == CHAOS_LOG_TRACE_RECORDS_PER_LINE) {
+        putchar('\n');
+        in_line = 0;
+      }
+    }
+    /* Remove input from ringbuf */
+    ringbufindex_get(&log_ringbuf);
+  }
+  if(in_line != 0) {
+    putchar('\n');
+  }
+}
+#else /* CHAOS_LOG_TRACE */
 /* Process pending log messages */
 void
 chaos_log_process_pending()
@@ -131,6 +216,7 @@ chaos_log_process_pending()
     ringbufindex_get(&log_ringbuf);
   }
 }
+#endif /* CHAOS_LOG_TRACE */
 
 /* Prepare addition of a new log.
  * Returns pointer to log structure if success, NULL otherwise */
@@ -53,6 +53,22 @@
 #define WITH_CHAOS_LOG 1
 #endif
 
+/* Drain the slot logs as raw binary records instead of formatted text.
+ * Use tools/cooja/apps/cooja-vanet-plugin ChaosTraceDecoder to get CSV back. */
+#ifndef CHAOS_LOG_TRACE
+#define CHAOS_LOG_TRACE 0
+#endif
+
+/* Line prefix of the binary trace output */
+#ifndef CHAOS_LOG_TRACE_PREFIX
+#define CHAOS_LOG_TRACE_PREFIX "#CHAOS-TRACE "
+#endif
+
+/* Number of records per output line */
+#ifndef CHAOS_LOG_TRACE_RECORDS_PER_LINE
+#define CHAOS_LOG_TRACE_RECORDS_PER_LINE 16
+#endif
+
 #if !NETSTACK_CONF_WITH_CHAOS_NODE_DYNAMIC
 #define FLAGS_LEN   ((CHAOS_NODES >> 3) + ((CHAOS_NODES & 7) ? 1 : 0))
 #else
@@ -101,6 +117,9 @@ typedef struct chaos_log_struct_t {
 #if CHAOS_LOG_FLAGS
       uint8_t app_flags[LOG_APP_FLAGS_LEN];
 #endif /* CHAOS_LOG_FLAGS */
+#if CHAOS_LOG_TRACE
+      uint8_t flag_progress; /* number of set app flags */
+#endif /* CHAOS_LOG_TRACE */
       uint8_t state:4, rx_status:4;
     } txrx;
   };
@@ -118,6 +137,23 @@ void chaos_log_init();
 /* Process pending log messages */
 void chaos_log_process_pending();
 
+#if CHAOS_LOG_TRACE
+/* Number of set bits in the app flags, with a nibble lookup to keep it cheap in the slot */
+static inline uint8_t
+chaos_log_count_flags(const uint8_t* flags, uint8_t len)
+{
+  static const uint8_t nibble_bits[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+  uint8_t count = 0;
+  if(flags != NULL) {
+    while(len--) {
+      count += nibble_bits[*flags & 0xf] + nibble_bits[*flags >> 4];
+      flags++;
+    }
+  }
+  return count;
+}
+#endif /* CHAOS_LOG_TRACE */
+
 #define CHAOS_LOG_ADD(log_type, init_code) do { \
     chaos_log_t *log = chaos_log_prepare_add(); \
     if(log != NULL) { \
@@ -170,7 +170,7 @@ ALWAYS_INLINE uint16_t
   uint8_t channel_sequence_offset = 0;
 #if CHAOS_MULTI_CHANNEL_PARALLEL_SEQUENCES
   if(slot_number > 0) { /* don't mess first slot for quicker association */
-    channel_sequence_offset = chaos_random_generator_fast() % CHAOS_MULTI_CHANNEL_PARALLEL_SEQUENCES;
+    channel_sequence_offset = chaos_random_generator_stream_fast(CHAOS_RANDOM_STREAM_HOPPING) % CHAOS_MULTI_CHANNEL_PARALLEL_SEQUENCES;
   }
 #endif /* CHAOS_MULTI_CHANNEL_PARALLEL_SEQUENCES */
   return chaos_channel_hopping_sequence[((round_number<<CHAOS_HOPPING_ROUND_SHIFT) + slot_number + channel_sequence_offset) & (CHAOS_HOPPING_SEQUENCE_SIZE-1)];
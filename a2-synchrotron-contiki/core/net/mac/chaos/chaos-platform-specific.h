@@ -530,6 +530,110 @@ chaos_radio_init(void)
 #endif /* CHAOS_HW_SECURITY */
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+#elif CONTIKI_TARGET_COOJA
+
+/* Native Cooja mote: slots run on the 1 ms simulation clock, see
+ * platform/cooja/rtimer-arch.h. There is no DCO to calibrate or to
+ * busy-wait on. */
+
+/* timing */
+#define RTIMER_MIN_DELAY 1
+#define chaos_platform_sync_dco_log(R, E)
+#define chaos_clock_delay(i) ((void)(i))
+#define chaos_clock_delay_exact(i) ((void)(i))
+/*---------------------------------------------------------------------------*/
+
+/* radio */
+#include "dev/cooja-radio.h"
+#include "net/mac/chaos/chaos.h"
+#include "net/mac/chaos/chaos-header.h"
+#include "dev/cooja-debug.h"
+
+#define NETSTACK_RADIO_set_channel(C)           radio_set_channel((C))
+#define NETSTACK_RADIO_flushrx()                radio_flushrx()
+#define NETSTACK_RADIO_fast_send(X,S)           chaos_cooja_fast_send(X,S)
+#define NETSTACK_RADIO_fast_rx(sfd_vht, round_synced, app_id, association, rx_packet, slot_length) \
+        chaos_cooja_fast_rx(sfd_vht, round_synced, app_id, association, rx_packet, slot_length)
+/*---------------------------------------------------------------------------*/
+static inline void
+chaos_radio_init(void)
+{
+  radio_set_channel(CHAOS_RF_CHANNEL);
+  radio_flushrx();
+}
+/*---------------------------------------------------------------------------*/
+/* The frame goes out in the current millisecond. The length byte and the
+ * footer (CRC) are not sent, the receiver restores them. */
+static inline int
+chaos_cooja_fast_send(const uint8_t * const buffer, uint16_t *sfd)
+{
+  *sfd = DCO_NOW();
+  return radio_send_immediately(buffer + 1, buffer[0] - FOOTER_LEN) == RADIO_TX_OK;
+}
+/*---------------------------------------------------------------------------*/
+static inline int
+chaos_cooja_fast_rx(vht_clock_t* sfd_vht, int round_synced, uint8_t app_id, uint8_t association, uint8_t * const rx_packet, rtimer_clock_t slot_length)
+{
+  chaos_header_t* const rx_header = (chaos_header_t*)((uint32_t *)rx_packet);
+  const uint8_t max_packet_size = sizeof(chaos_header_t) + FOOTER_LEN + LLSEC802154_MIC_LENGTH + CHAOS_MAX_PAYLOAD_LEN;
+  /* time stamps are peeked, only the busy-waits yield to Cooja */
+  rtimer_clock_t begin = rtimer_arch_peek();
+  rtimer_clock_t timeout;
+  int len;
+
+  if( association ){
+    timeout = begin + slot_length;
+  } else {
+    timeout = begin + 1 + (round_synced ? RX_GUARD_TIME : ROUND_GUARD_TIME);
+  }
+  /* the SFD is the millisecond in which Cooja starts the reception */
+  while( !NETSTACK_RADIO.receiving_packet() && !NETSTACK_RADIO.pending_packet()
+      && RTIMER_CLOCK_LT(RTIMER_NOW(), timeout) );
+  if( !NETSTACK_RADIO.receiving_packet() && !NETSTACK_RADIO.pending_packet() ){
+    *sfd_vht = VHT_NOW();
+    return CHAOS_RX_NO_SFD;
+  }
+  begin = rtimer_arch_peek();
+  *sfd_vht = RTIMER_TO_VHT(begin);
+
+  timeout = begin + slot_length;
+  while( !NETSTACK_RADIO.pending_packet() && RTIMER_CLOCK_LT(RTIMER_NOW(), timeout) );
+  if( !NETSTACK_RADIO.pending_packet() ){
+    /* interfered or still on the air */
+    NETSTACK_RADIO_flushrx();
+    return CHAOS_RX_TIMEOUT;
+  }
+
+  len = NETSTACK_RADIO.read(rx_packet + 1, max_packet_size - FOOTER_LEN);
+  if( len < (int)(sizeof(chaos_header_t) - 1 + LLSEC802154_MIC_LENGTH) ){
+    COOJA_DEBUG_STR("length err");
+    return CHAOS_TXRX_ERROR;
+  }
+  rx_packet[0] = len + FOOTER_LEN;
+
+  if ((rx_header->chaos_fcf_0 != CHAOS_FCF_0
+        && rx_header->chaos_fcf_0 != CHAOS_FCF_0_NO_SECURITY)
+      || rx_header->chaos_fcf_1 != CHAOS_FCF_1) {
+    COOJA_DEBUG_STR("wrong header");
+    return CHAOS_RX_HEADER_ERROR;
+  }
+  if (rx_header->dst_pan_id != CHAOS_PANID
+#if CHAOS_USE_DST_ID
+      || (rx_header->dst_node_id != FRAME802154_BROADCASTADDR
+          && rx_header->dst_node_id != node_id)
+#endif
+          ) {
+    COOJA_DEBUG_STR("wrong pan id or node id");
+    return CHAOS_RX_HEADER_ERROR;
+  }
+
+  /* Cooja only delivers frames that were received without errors */
+  CHAOS_RSSI_FIELD(rx_packet) = radio_signal_strength_last();
+  CHAOS_CRC_FIELD(rx_packet) = FOOTER1_CRC_OK | (radio_LQI() & FOOTER1_CORRELATION);
+  return CHAOS_TXRX_OK;
+}
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 #elif CONTIKI_TARGET_CC2538DK
@@ -46,22 +46,75 @@
 #if CONTIKI_TARGET_SKY || CONTIKI_TARGET_WSN430
 unsigned int msp430_rand(void);
 #define HW_RND() msp430_rand()
+#elif CONTIKI_TARGET_COOJA
+#include "lib/random.h"
+/* seeded by Cooja with the simulation random seed */
+#define HW_RND() random_rand()
 #else
 #warning "define a HW random generator function for proper random seeds"
 #define HW_RND() DCO_NOW()
 #endif
 
-/* TODO: make a lookup table that is updated between rounds */
+#if CHAOS_RANDOM_COOJA_SEED
+unsigned short rseed = 0; /* Will be set to a value by cooja! */
+#endif
+
+#if (CHAOS_RANDOM_HOPPING_TABLE_SIZE & (CHAOS_RANDOM_HOPPING_TABLE_SIZE - 1)) \
+  || (CHAOS_RANDOM_TX_TABLE_SIZE & (CHAOS_RANDOM_TX_TABLE_SIZE - 1)) \
+  || (CHAOS_RANDOM_FAILURE_TABLE_SIZE & (CHAOS_RANDOM_FAILURE_TABLE_SIZE - 1))
+#error "CHAOS_RANDOM_*_TABLE_SIZE must be a power of two"
+#endif
+
+#if CHAOS_RANDOM_HOPPING_TABLE_SIZE > 256 || CHAOS_RANDOM_TX_TABLE_SIZE > 256 \
+  || CHAOS_RANDOM_FAILURE_TABLE_SIZE > 256
+#error "CHAOS_RANDOM_*_TABLE_SIZE must not exceed 256"
+#endif
+
+typedef struct {
+#if !CHAOS_USE_MSPGCC_RAND
+  uint32_t z1, z2, z3, z4;
+#endif
+  uint32_t* table;
+  uint16_t size;
+  uint16_t consumed;  /* entries handed out since the last refill */
+  uint8_t idx;        /* next entry to hand out */
+} chaos_random_stream_state_t;
+
+#if CHAOS_RANDOM_HOPPING_TABLE_SIZE
+static uint32_t hopping_table[CHAOS_RANDOM_HOPPING_TABLE_SIZE];
+#else
+#define hopping_table NULL
+#endif
+#if CHAOS_RANDOM_TX_TABLE_SIZE
+static uint32_t tx_table[CHAOS_RANDOM_TX_TABLE_SIZE];
+#else
+#define tx_table NULL
+#endif
+#if CHAOS_RANDOM_FAILURE_TABLE_SIZE
+static uint32_t failure_table[CHAOS_RANDOM_FAILURE_TABLE_SIZE];
+#else
+#define failure_table NULL
+#endif
+
+static chaos_random_stream_state_t streams[CHAOS_RANDOM_STREAM_COUNT] = {
+  [CHAOS_RANDOM_STREAM_HOPPING] = { .table = hopping_table, .size = CHAOS_RANDOM_HOPPING_TABLE_SIZE },
+  [CHAOS_RANDOM_STREAM_TX] = { .table = tx_table, .size = CHAOS_RANDOM_TX_TABLE_SIZE },
+  [CHAOS_RANDOM_STREAM_FAILURE] = { .table = failure_table, .size = CHAOS_RANDOM_FAILURE_TABLE_SIZE },
+};
+
 #if CHAOS_USE_MSPGCC_RAND
 #include "lib/random.h"
-uint32_t
-chaos_random_generator() {
+/* mspgcc rand has a single global state, streams only differ by their tables */
+static uint32_t
+stream_produce(chaos_random_stream_state_t* s) {
   return random_rand();
 }
 
-void
-chaos_random_generator_set_seed(uint32_t seed) {
-  random_init((uint16_t)(seed >> 16UL));
+static void
+stream_set_seed(chaos_random_stream_state_t* s, uint32_t seed) {
+  if(s == &streams[0]) {
+    random_init((uint16_t)(seed >> 16UL));
+  }
 }
 #else /* CHAOS_USE_MSPGCC_RAND */
 
@@ -79,56 +132,105 @@ chaos_random_generator_set_seed(uint32_t seed) {
 * 1, 7, 15, and 127 respectively.
 */
 #define SEED 12345UL
-static uint32_t z1 = SEED, z2 = SEED, z3 = SEED, z4 = SEED;
+/* bit 7 keeps every component above the lfsr113 minimum */
+#define SEED_MIN_BITS 0x80UL
+
+/* LCG step (Numerical Recipes) to derive the four components from one seed */
+#define SEED_NEXT(x) ((x) * 1664525UL + 1013904223UL)
+
+static void
+stream_set_seed(chaos_random_stream_state_t* s, uint32_t seed) {
+  s->z1 = (seed = SEED_NEXT(seed)) | SEED_MIN_BITS;
+  s->z2 = (seed = SEED_NEXT(seed)) | SEED_MIN_BITS;
+  s->z3 = (seed = SEED_NEXT(seed)) | SEED_MIN_BITS;
+  s->z4 = (seed = SEED_NEXT(seed)) | SEED_MIN_BITS;
+}
+
+static uint32_t
+stream_produce(chaos_random_stream_state_t* s) {
+  uint32_t b;
+  b  = ((s->z1 << 6UL) ^ s->z1) >> 13UL;
+  s->z1 = ((s->z1 & 4294967294UL) << 18UL) ^ b;
+  b  = ((s->z2 << 2UL) ^ s->z2) >> 27UL;
+  s->z2 = ((s->z2 & 4294967288UL) << 2UL) ^ b;
+  b  = ((s->z3 << 13UL) ^ s->z3) >> 21UL;
+  s->z3 = ((s->z3 & 4294967280UL) << 7) ^ b;
+  b  = ((s->z4 << 3UL) ^ s->z4) >> 12UL;
+  s->z4 = ((s->z4 & 4294967168UL) << 13UL) ^ b;
+  return (s->z1 ^ s->z2 ^ s->z3 ^ s->z4);
+}
+#endif /* CHAOS_USE_MSPGCC_RAND */
+
+static void
+stream_fill_table(chaos_random_stream_state_t* s) {
+  uint16_t i;
+  for(i = 0; i < s->size; i++) {
+    s->table[i] = stream_produce(s);
+  }
+  s->idx = 0;
+  s->consumed = 0;
+}
 
 void
 chaos_random_generator_set_seed(uint32_t seed) {
+#if !CHAOS_USE_MSPGCC_RAND
   if(seed < 127) {
     seed += SEED + node_id * node_id;
   }
-  z1 = z2 = z3 = z4 = seed;
+#endif
+  uint8_t i;
+  for(i = 0; i < CHAOS_RANDOM_STREAM_COUNT; i++) {
+    /* golden ratio increment keeps the stream seeds apart */
+    stream_set_seed(&streams[i], seed + i * 0x9E3779B9UL);
+    stream_fill_table(&streams[i]);
+  }
 }
 
 uint32_t
-chaos_random_generator_produce() {
-  uint32_t b, z;
-  b  = ((z1 << 6UL) ^ z1) >> 13UL;
-  z1 = ((z1 & 4294967294UL) << 18UL) ^ b;
-  b  = ((z2 << 2UL) ^ z2) >> 27UL;
-  z2 = ((z2 & 4294967288UL) << 2UL) ^ b;
-  b  = ((z3 << 13UL) ^ z3) >> 21UL;
-  z3 = ((z3 & 4294967280UL) << 7) ^ b;
-  b  = ((z4 << 3UL) ^ z4) >> 12UL;
-  z4 = ((z4 & 4294967168UL) << 13UL) ^ b;
-  z = (z1 ^ z2 ^ z3 ^ z4);
-  return z;
+chaos_random_generator_stream_produce(chaos_random_stream_t stream) {
+  return stream_produce(&streams[stream]);
 }
-#endif /* CHAOS_USE_MSPGCC_RAND */
 
-#define CHAOS_RND_TABLE_SIZE 512
-static uint8_t random_idx = 0;
-static uint32_t random_table[CHAOS_RND_TABLE_SIZE] = {0UL};
+uint32_t
+chaos_random_generator_stream_fast(chaos_random_stream_t stream) {
+  chaos_random_stream_state_t* s = &streams[stream];
+  if(s->size == 0) {
+    return stream_produce(s);
+  }
+  if(s->consumed < s->size) {
+    s->consumed++;
+  }
+  /* the index is 8 bits wide, so masking is enough to wrap */
+  return s->table[s->idx++ & (s->size - 1)];
+}
 
 void
 chaos_random_generator_update_table()
 {
-  random_idx = 0;
-  int i;
-  for(i=0; i<CHAOS_RND_TABLE_SIZE; i++) {
-    random_table[i] = chaos_random_generator_produce();
+  uint8_t i;
+  for(i = 0; i < CHAOS_RANDOM_STREAM_COUNT; i++) {
+    chaos_random_stream_state_t* s = &streams[i];
+    /* refill the consumed entries in the order they were handed out, so
+     * the sequence only depends on the seed and the number of draws.
+     * Unused entries stay valid and are handed out next. */
+    uint8_t pos = s->idx - s->consumed;
+    while(s->consumed > 0) {
+      s->table[pos++ & (s->size - 1)] = stream_produce(s);
+      s->consumed--;
+    }
   }
 }
 
 void
 chaos_random_generator_init(void)
 {
+#if CHAOS_RANDOM_COOJA_SEED
+  if(rseed != 0) {
+    chaos_random_generator_set_seed(((uint32_t)rseed << 16UL) | rseed);
+    return;
+  }
+#endif
   uint16_t random_seed_l = HW_RND() + ((node_id << 8U) | (node_id & 0xffU));
   uint32_t random_seed = random_seed_l + ((uint32_t)random_seed_l << 16UL);
   chaos_random_generator_set_seed(random_seed);
-  chaos_random_generator_update_table();
-}
-
-uint32_t
-chaos_random_generator_fast() {
-  return random_table[random_idx++ % CHAOS_RND_TABLE_SIZE];
 }
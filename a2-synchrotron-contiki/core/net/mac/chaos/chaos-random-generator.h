@@ -44,12 +44,49 @@
 
 #include "contiki.h"
 
-uint32_t chaos_random_generator_produce();
-uint32_t chaos_random_generator_fast();
+/* Independent random streams, so that e.g. the amount of failure injection
+ * does not shift the back-off or hopping decisions of a node */
+typedef enum {
+  CHAOS_RANDOM_STREAM_HOPPING = 0,  /* channel hopping and association */
+  CHAOS_RANDOM_STREAM_TX,           /* tx decisions and restart back-off */
+  CHAOS_RANDOM_STREAM_FAILURE,      /* FAILURES_RATE failure injection */
+  CHAOS_RANDOM_STREAM_COUNT
+} chaos_random_stream_t;
+
+/* Pre-computed values per stream for the fast path. Sizes must be a power of
+ * two (or zero to always compute on demand) and not larger than 256. */
+#ifndef CHAOS_RANDOM_HOPPING_TABLE_SIZE
+#define CHAOS_RANDOM_HOPPING_TABLE_SIZE 0
+#endif
+
+#ifndef CHAOS_RANDOM_TX_TABLE_SIZE
+#define CHAOS_RANDOM_TX_TABLE_SIZE 256
+#endif
+
+#ifndef CHAOS_RANDOM_FAILURE_TABLE_SIZE
+#define CHAOS_RANDOM_FAILURE_TABLE_SIZE 64
+#endif
+
+/* Seed from the Cooja provided rseed (simulation seed + node id) instead of
+ * the hardware source, so two runs with the same seed behave identically */
+#ifndef CHAOS_RANDOM_COOJA_SEED
+#define CHAOS_RANDOM_COOJA_SEED COOJA
+#endif
+
+#if CHAOS_RANDOM_COOJA_SEED
+extern unsigned short rseed; /* Will be set to a value by cooja! */
+#endif
+
+uint32_t chaos_random_generator_stream_produce(chaos_random_stream_t stream);
+uint32_t chaos_random_generator_stream_fast(chaos_random_stream_t stream);
 void chaos_random_generator_set_seed(uint32_t seed);
 void chaos_random_generator_init(void);
+/* Recompute only the table entries that were consumed since the last call */
 void chaos_random_generator_update_table();
 
+#define chaos_random_generator_produce() chaos_random_generator_stream_produce(CHAOS_RANDOM_STREAM_TX)
+#define chaos_random_generator_fast() chaos_random_generator_stream_fast(CHAOS_RANDOM_STREAM_TX)
+
 #if CHAOS_USE_MSPGCC_RAND
 #define CHAOS_RANDOM_MAX (RAND_MAX)
 #else
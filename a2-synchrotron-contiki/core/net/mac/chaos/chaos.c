@@ -63,8 +63,14 @@
 #include "chaos-control.h"
 #include "chaos-random-generator.h"
 
+#if CONTIKI_TARGET_COOJA
+/* no DCO part to wait for: go in the tick of the goal */
+#define CHAOS_TX_RTIMER_GUARD 0
+#define CHAOS_RX_RTIMER_GUARD 0
+#else
 #define CHAOS_TX_RTIMER_GUARD 1
 #define CHAOS_RX_RTIMER_GUARD 1
+#endif
 
 /* busy wait at the end of a premature slot, or wait only at the beginning of a slot? */
 #define BUSYWAIT_UNTIL_SLOT_END 1
@@ -254,13 +260,21 @@ chaos_get_security_key_pointer()
 static void
 on(void)
 {
+#if CONTIKI_TARGET_COOJA
+  NETSTACK_RADIO.on();
+#else
   cc2420_fast_on();
+#endif
 }
 /*---------------------------------------------------------------------------*/
 static void
 off(void)
 {
+#if CONTIKI_TARGET_COOJA
+  NETSTACK_RADIO.off();
+#else
   cc2420_fast_off();
+#endif
 }
 /*---------------------------------------------------------------------------*/
 static unsigned short
@@ -318,9 +332,11 @@ chaos_tx_slot(rtimer_clock_t* sfd_dco){
   tx_status = NETSTACK_RADIO_fast_send(tx_packet, (uint16_t*)sfd_dco);
 
 //  tx_status = chaos_random_generator_fast()+2;
+#if !CONTIKI_TARGET_COOJA /* fast_send returns when Cooja has taken the frame */
   if(tx_status) {
     BUSYWAIT_UNTIL(!CC2420_SFD_IS_1, CHAOS_PACKET_DURATION(CHAOS_PACKET_RADIO_LENGTH(tx_header->length)));
   }
+#endif
   LEDS_OFF(LEDS_GREEN);
   return tx_status ? CHAOS_TXRX_OK : CHAOS_TXRX_ERROR;
 }
@@ -826,6 +842,9 @@ chaos_round(const uint16_t round_number, const uint8_t app_id, const uint8_t* co
           memcpy(log->txrx.app_flags, app_flags, MIN(app_flags_len, LOG_APP_FLAGS_LEN));
         }
 #endif /* CHAOS_LOG_FLAGS */
+#if CHAOS_LOG_TRACE
+        log->txrx.flag_progress = (round_synced && app_flags) ? chaos_log_count_flags(app_flags, app_flags_len) : 0;
+#endif /* CHAOS_LOG_TRACE */
 #if NETSTACK_CONF_WITH_CHAOS_NODE_DYNAMIC
         void* payload = ( chaos_state_backup_log == CHAOS_RX ) ? rx_header->payload : tx_header->payload;
         log->txrx.join_committed = join_is_committed_from_payload( payload );
@@ -923,7 +942,7 @@ uint8_t chaos_associate(rtimer_clock_t* t_sfd_actual_rtimer_ptr, uint16_t *round
     const chaos_app_t* app =  NULL;
     uint16_t association_counter = 0;
     round_synced = 0;
-    HOP_CHANNEL(round_number, chaos_random_generator_produce());
+    HOP_CHANNEL(round_number, chaos_random_generator_stream_produce(CHAOS_RANDOM_STREAM_HOPPING));
     on();
 
     /* repeat until we get a valid packet */
@@ -993,6 +1012,9 @@ uint8_t chaos_associate(rtimer_clock_t* t_sfd_actual_rtimer_ptr, uint16_t *round
 #endif
 //      log->txrx.t_go_delta = round_rtimer;
       log->txrx.t_sfd_delta = round_rtimer;
+#if CHAOS_LOG_TRACE
+      log->txrx.flag_progress = 0;
+#endif /* CHAOS_LOG_TRACE */
       //TODO: some more logging here?
   });
   UNSET_PIN_ADC6;
@@ -93,8 +93,13 @@
 #define LEDS_OFF(X) leds_off((X))
 #define LEDS_BLINK() leds_blink()
 #define LEDS_TOGGLE(X) leds_toggle((X))
+#if CONTIKI_TARGET_COOJA
+#define RX_LEDS_DELAY (0)
+#define TX_LEDS_DELAY (0)
+#else
 #define RX_LEDS_DELAY (DCO_TO_VHT(130/2))
 #define TX_LEDS_DELAY (DCO_TO_VHT(130/2))
+#endif
 #else
 #define LEDS_ON(X)
 #define LEDS_OFF(X)
@@ -269,7 +274,13 @@ void chaos_set_is_initiator(uint8_t);
 
 /* radio speed related */
 /* ~327us+129preample */
-#if COOJA /* dividing by 2 since the numbers were calculated on 4MHz and we are running on 2MHz in Cooja*/
+#if CONTIKI_TARGET_COOJA /* native mote: the radio has no delays at 1 ms resolution */
+#define CHAOS_TX_DELAY_VHT (0)
+#define CHAOS_RX_DELAY_VHT (0)
+#define PREP_RX_VHT (0)
+#define PREP_TX_VHT (0)
+#define VHT_MIN_DELAY (0)
+#elif COOJA /* dividing by 2 since the numbers were calculated on 4MHz and we are running on 2MHz in Cooja*/
 //#define CHAOS_TX_DELAY_VHT_OFF (0xd9500uL)
 //#define CHAOS_TX_DELAY_VHT (0xd9500uL)
 //#define CHAOS_RX_DELAY_VHT (0xee200uL)
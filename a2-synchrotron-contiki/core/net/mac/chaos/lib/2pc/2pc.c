@@ -243,7 +243,7 @@ process(uint16_t round_count, uint16_t slot_count, chaos_state_t current_state,
 
 #if FAILURES_RATE
 #warning "INJECT_FAILURES!!"
-  if(/*tx_two_pc->phase == PHASE_PROPOSE && */chaos_random_generator_fast() < 1*(CHAOS_RANDOM_MAX/(FAILURES_RATE))){
+  if(/*tx_two_pc->phase == PHASE_PROPOSE && */chaos_random_generator_stream_fast(CHAOS_RANDOM_STREAM_FAILURE) < 1*(CHAOS_RANDOM_MAX/(FAILURES_RATE))){
     next_state = CHAOS_OFF;
   }
 #endif
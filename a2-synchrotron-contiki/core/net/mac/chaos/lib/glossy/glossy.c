@@ -56,23 +56,69 @@
 #define GLOSSY_RESTART_INTERVAL 5
 #endif
 
-#define CHAOS_GLOSSY_RETX 1
+#ifndef GLOSSY_N_TX_MIN
+#define GLOSSY_N_TX_MIN 2
+#endif
+
+/* Slots on top of the hops and transmissions of the farthest node */
+#ifndef GLOSSY_SLOT_MARGIN
+#define GLOSSY_SLOT_MARGIN 4
+#endif
 
-typedef uint32_t diss_t;
+/* Stop relaying once a node farther away was heard relaying, needs GLOSSY_ADAPTIVE.
+ * This is a heuristic only: there may be other neighbors still waiting for the flood */
+#ifndef GLOSSY_EARLY_OFF
+#define GLOSSY_EARLY_OFF 0
+#endif
 
-static diss_t diss_local;
+#define CHAOS_GLOSSY_RETX 1
+
+static uint8_t flood_local[CHAOS_MAX_PAYLOAD_LEN];
 static uint16_t off_slot, complete_slot;
 static int got_valid_rx, tx_count, idle_count;
+static uint8_t n_tx;
+
+#if GLOSSY_ADAPTIVE
+static int heard_farther;
+static uint8_t hop, max_hop, max_slots;
+
+/* kept by the initiator over the rounds, 0 if nobody was heard in the last round */
+static uint8_t last_max_hop = 0;
+
+static void set_header(uint8_t* payload) {
+  glossy_header_t* header = (glossy_header_t*) payload;
+  header->hop = hop;
+  header->max_hop = max_hop;
+  header->n_tx = n_tx;
+  header->max_slots = max_slots;
+}
+#endif /* GLOSSY_ADAPTIVE */
 
 static chaos_state_t process(uint16_t round_count, uint16_t slot_count, chaos_state_t current_state, int chaos_txrx_success, size_t payload_length, uint8_t* rx_payload, uint8_t* tx_payload, uint8_t** app_flags){
 
-  if( current_state == CHAOS_RX && chaos_txrx_success && !got_valid_rx) {
-    memcpy((void *)tx_payload, (void *)rx_payload, payload_length);
+  if( current_state == CHAOS_RX && chaos_txrx_success && !got_valid_rx && !IS_INITIATOR() ) {
+    memcpy((void *)flood_local, (void *)rx_payload, payload_length);
     complete_slot = slot_count + 1;
     got_valid_rx = 1;
-    diss_local = *(diss_t *)tx_payload;
+#if GLOSSY_ADAPTIVE
+    glossy_header_t* rx_header = (glossy_header_t*) rx_payload;
+    hop = rx_header->hop + 1;
+    n_tx = rx_header->n_tx;
+    max_slots = rx_header->max_slots;
+#endif /* GLOSSY_ADAPTIVE */
   }
 
+#if GLOSSY_ADAPTIVE
+  if( current_state == CHAOS_RX && chaos_txrx_success ) {
+    glossy_header_t* rx_header = (glossy_header_t*) rx_payload;
+    max_hop = MAX(max_hop, MAX(rx_header->max_hop, rx_header->hop));
+    max_hop = MAX(max_hop, hop);
+    if( rx_header->hop > hop ) {
+      heard_farther = 1;
+    }
+  }
+#endif /* GLOSSY_ADAPTIVE */
+
   chaos_state_t next_state = CHAOS_RX;
   if( current_state == CHAOS_INIT ){
     next_state = IS_INITIATOR() ? CHAOS_TX : CHAOS_RX; //for the first tx of the initiator: no increase of tx_count here
@@ -88,12 +134,28 @@ static chaos_state_t process(uint16_t round_count, uint16_t slot_count, chaos_st
   } else if( current_state == CHAOS_TX ){
     tx_count++;
     next_state = CHAOS_RX;
-    if(tx_count > GLOSSY_N_TX){
+    if(tx_count > n_tx){
       next_state = CHAOS_OFF;
     }
   }
 
-  if(next_state == CHAOS_OFF){
+#if GLOSSY_ADAPTIVE
+  if( GLOSSY_EARLY_OFF && heard_farther && tx_count > 0 && !IS_INITIATOR() ){
+    next_state = CHAOS_OFF;
+  }
+
+  /* the slot budget of the initiator, nodes without reception use the maximum */
+  if( slot_count + 1 >= max_slots ){
+    next_state = CHAOS_OFF;
+  }
+#endif /* GLOSSY_ADAPTIVE */
+
+  if(next_state == CHAOS_TX){
+    memcpy((void *)tx_payload, (void *)flood_local, payload_length);
+#if GLOSSY_ADAPTIVE
+    set_header(tx_payload);
+#endif /* GLOSSY_ADAPTIVE */
+  } else if(next_state == CHAOS_OFF){
     off_slot = slot_count;
   }
 
@@ -104,6 +166,22 @@ uint16_t glossy_get_off_slot(){
   return off_slot;
 }
 
+uint8_t glossy_get_hop(){
+#if GLOSSY_ADAPTIVE
+  return hop;
+#else
+  return 0;
+#endif
+}
+
+uint8_t glossy_get_max_hop(){
+#if GLOSSY_ADAPTIVE
+  return max_hop;
+#else
+  return 0;
+#endif
+}
+
 int glossy_is_pending(const uint16_t round_count){
   return 1;
 }
@@ -112,18 +190,58 @@ static int glossy_get_flags_length() {
   return 0;
 }
 
-uint16_t glossy_round_begin(const uint16_t round_number, const uint8_t app_id, uint32_t* diss_value){
+uint16_t glossy_flood(const uint16_t round_number, const uint8_t app_id, uint8_t* payload, const uint8_t payload_length){
+  if( payload_length > GLOSSY_MAX_PAYLOAD_LEN ){
+    COOJA_DEBUG_STR("glossy: payload too long");
+    return 0;
+  }
+
   got_valid_rx = 0;
   tx_count = 0;
   idle_count = 0;
-  diss_local = 0;
   off_slot = CHAOS_GLOSSY_ROUND_MAX_SLOTS;
   complete_slot = 0;
+  n_tx = GLOSSY_N_TX;
+  memset(flood_local, 0, sizeof(flood_local));
+#if GLOSSY_ADAPTIVE
+  heard_farther = 0;
+  hop = 0;
+  max_hop = 0;
+  max_slots = CHAOS_GLOSSY_ROUND_MAX_SLOTS;
+#endif /* GLOSSY_ADAPTIVE */
+
+  if( IS_INITIATOR() ){
+#if GLOSSY_ADAPTIVE
+    /* without an estimate from the last round the defaults are used */
+    if( last_max_hop > 0 ){
+      /* deeper networks need more transmissions, every hop and transmission takes a slot */
+      n_tx = MAX(GLOSSY_N_TX_MIN, MIN(GLOSSY_N_TX, last_max_hop + 1));
+      max_slots = MIN(CHAOS_GLOSSY_ROUND_MAX_SLOTS, last_max_hop + 2*(n_tx + 1) + GLOSSY_SLOT_MARGIN);
+    }
+    set_header(flood_local);
+#endif /* GLOSSY_ADAPTIVE */
+    memcpy(flood_local + GLOSSY_HEADER_LEN, payload, payload_length);
+  }
+
+  chaos_round(round_number, app_id, (const uint8_t const*)flood_local, GLOSSY_HEADER_LEN + payload_length, CHAOS_GLOSSY_SLOT_LEN_DCO, CHAOS_GLOSSY_ROUND_MAX_SLOTS, glossy_get_flags_length(), process);
+
+#if GLOSSY_ADAPTIVE
+  if( IS_INITIATOR() ){
+    last_max_hop = max_hop;
+  }
+#endif /* GLOSSY_ADAPTIVE */
+  if( !IS_INITIATOR() ){
+    memcpy(payload, flood_local + GLOSSY_HEADER_LEN, payload_length);
+  }
+  return complete_slot;
+}
 
+uint16_t glossy_round_begin(const uint16_t round_number, const uint8_t app_id, uint32_t* diss_value){
+  uint32_t diss_local = 0;
   if( IS_INITIATOR() ){
     diss_local = *diss_value;
   }
-  chaos_round(round_number, app_id, (const uint8_t const*)&diss_local, sizeof(diss_local), CHAOS_GLOSSY_SLOT_LEN_DCO, CHAOS_GLOSSY_ROUND_MAX_SLOTS, glossy_get_flags_length(), process);
+  uint16_t complete = glossy_flood(round_number, app_id, (uint8_t*)&diss_local, sizeof(diss_local));
   *diss_value = diss_local;
-  return complete_slot;
+  return complete;
 }
@@ -44,8 +44,36 @@
 #define CHAOS_GLOSSY_SLOT_LEN_DCO      (CHAOS_GLOSSY_SLOT_LEN*CLOCK_PHI)
 #define CHAOS_GLOSSY_ROUND_MAX_SLOTS   20     //force radio off after CHAOS_ROUND_MAX_SLOTS slots
 
+/* Let the initiator size N_TX and the slot budget from the hop distances of the last round.
+ * Adds a glossy_header_t to every packet, off until it has been evaluated */
+#ifndef GLOSSY_ADAPTIVE
+#define GLOSSY_ADAPTIVE 0
+#endif
+
+/* Piggybacked on every flood in adaptive mode, so the initiator can size the next rounds */
+typedef struct __attribute__((packed)) {
+  uint8_t hop;       /* hop distance of the sender to the initiator */
+  uint8_t max_hop;   /* largest hop distance the sender has heard of */
+  uint8_t n_tx;      /* transmissions per node, set by the initiator */
+  uint8_t max_slots; /* slot budget of the round, set by the initiator */
+} glossy_header_t;
+
+#if GLOSSY_ADAPTIVE
+#define GLOSSY_HEADER_LEN              sizeof(glossy_header_t)
+#else
+#define GLOSSY_HEADER_LEN              0
+#endif
+
+#define GLOSSY_MAX_PAYLOAD_LEN         (CHAOS_MAX_PAYLOAD_LEN - GLOSSY_HEADER_LEN)
+
+/* Floods payload_length bytes (same length on all nodes) from the initiator, returns the slot of the first reception.
+ * Payloads longer than GLOSSY_MAX_PAYLOAD_LEN are rejected: no round is run and 0 is returned */
+uint16_t glossy_flood(const uint16_t round_number, const uint8_t app_id, uint8_t* payload, const uint8_t payload_length);
 uint16_t glossy_round_begin(const uint16_t round_number, const uint8_t app_id, uint32_t* diss_value);
 uint16_t glossy_get_off_slot();
+/* hop distances of the last round, only known in adaptive mode */
+uint8_t glossy_get_hop();
+uint8_t glossy_get_max_hop();
 int glossy_is_pending(const uint16_t round_count);
 
 #endif /* _GLOSSY_H_ */
@@ -95,6 +95,14 @@
 /*((MERGE_COMMIT_MAX_COMMIT_SLOT)/2)*/
 #endif
 
+/* Decides if the initiator (with complete flags) moves on to the commit phase */
+#ifndef MERGE_COMMIT_SHOULD_COMMIT
+#define MERGE_COMMIT_SHOULD_COMMIT(slot_count, delta_at_slot) \
+  ((slot_count) >= MERGE_COMMIT_MAX_COMMIT_SLOT \
+   || (COMMIT_THRESHOLD && /*delta_at_slot > 0 && */ \
+       (slot_count) >= (delta_at_slot) + COMMIT_THRESHOLD))
+#endif
+
 
 #if MERGE_COMMIT_ADVANCED_STATS
 
@@ -114,7 +122,11 @@ typedef struct __attribute__((packed)) {
 } merge_commit_local_t;
 
 
+#ifdef MERGE_COMMIT_CALLBACK_HEADER
+#include MERGE_COMMIT_CALLBACK_HEADER
+#else
 extern void merge_commit_merge_callback(merge_commit_t* rx_mc, merge_commit_t* tx_mc);
+#endif
 
 // Enable me if maximum is wanted
 #if 0
@@ -311,6 +323,7 @@ inline uint8_t initiator_try_rejoin_node(merge_commit_t *tx_mc, join_data_t* joi
   return tx;
 }
 
+#if MERGE_COMMIT_WITH_ELECTION
 inline uint8_t handle_election_round(uint16_t round_count, uint16_t slot_count, merge_commit_t* tx_mc, merge_commit_t* rx_mc) {
 
   uint8_t* tx_leaves = merge_commit_get_leaves(tx_mc);
@@ -474,6 +487,7 @@ inline uint8_t handle_election_round(uint16_t round_count, uint16_t slot_count,
 
   return tx;
 }
+#endif /* MERGE_COMMIT_WITH_ELECTION */
 
 
 inline uint8_t handle_coordination_round(uint16_t round_count, uint16_t slot_count, merge_commit_t* tx_mc, merge_commit_t* rx_mc) {
@@ -517,10 +531,7 @@ inline uint8_t handle_coordination_round(uint16_t round_count, uint16_t slot_cou
       }
 
       if (IS_INITIATOR()) {
-        if (flags_complete &&
-            (slot_count >= MERGE_COMMIT_MAX_COMMIT_SLOT
-             || (COMMIT_THRESHOLD && /*delta_at_slot > 0 && */
-                 slot_count >= delta_at_slot + COMMIT_THRESHOLD))) {
+        if (flags_complete && MERGE_COMMIT_SHOULD_COMMIT(slot_count, delta_at_slot)) {
           //LEDS_ON(LEDS_RED);
           memset(tx_flags, 0, merge_commit_get_flags_length());
           tx_flags[ARR_INDEX] |= 1 << (ARR_OFFSET);
@@ -708,9 +719,12 @@ inline uint8_t handle_received_packet(uint16_t round_count, uint16_t slot_count,
       tx = 1; // ignore it and retransmit!
     } else {
       // in this case, our own typ is either the same as the receied one, or unknown :)
+#if MERGE_COMMIT_WITH_ELECTION
       if (rx_mc->type == TYPE_ELECTION_AND_HANDOVER) {
         tx = handle_election_round(round_count, slot_count, tx_mc, rx_mc);
-      } else {
+      } else
+#endif /* MERGE_COMMIT_WITH_ELECTION */
+      {
         tx = handle_coordination_round(round_count, slot_count, tx_mc, rx_mc);
       }
     }
@@ -772,7 +786,7 @@ process(uint16_t round_count, uint16_t slot_count, chaos_state_t current_state,
 
 #if FAILURES_RATE
   #warning "INJECT_FAILURES!!"
-  if(!IS_INITIATOR() && chaos_random_generator_fast() < 1*(CHAOS_RANDOM_MAX/(FAILURES_RATE))){
+  if(!IS_INITIATOR() && chaos_random_generator_stream_fast(CHAOS_RANDOM_STREAM_FAILURE) < 1*(CHAOS_RANDOM_MAX/(FAILURES_RATE))){
     next_state = CHAOS_OFF;
     end = 1; // we still want the cleanups and so on
   }
@@ -859,7 +873,8 @@ int merge_commit_round_begin(const uint16_t round_number, const uint8_t app_id,
   mc_local.mc.phase = PHASE_MERGE; // valid for both the election and coordination
 
   // we never want an unknown type
-  if (merge_commit_wanted_type != TYPE_COORDINATION && merge_commit_wanted_type != TYPE_ELECTION_AND_HANDOVER) {
+  if (merge_commit_wanted_type != TYPE_COORDINATION
+      && (!MERGE_COMMIT_WITH_ELECTION || merge_commit_wanted_type != TYPE_ELECTION_AND_HANDOVER)) {
      merge_commit_wanted_type = TYPE_COORDINATION;
   }
 
@@ -867,7 +882,7 @@ int merge_commit_round_begin(const uint16_t round_number, const uint8_t app_id,
     rejoin_needed = 0;
 
     if(merge_commit_wanted_join_state == MERGE_COMMIT_WANTED_JOIN_STATE_LEAVE) {
-      if (chaos_node_count > 1) {
+      if (MERGE_COMMIT_WITH_ELECTION && chaos_node_count > 1) {
         mc_local.mc.type = TYPE_ELECTION_AND_HANDOVER;
         // We need to do a handover before we can leave!
         // Problem: If there is another node trying to leave, it should not need to be elected...
@@ -76,6 +76,19 @@
 #define MERGE_COMMIT_VALUE_STRUCT_CONTENT uint32_t x;
 #endif
 
+/* Header (in the include path of the app) that defines the merge callback as
+ * static inline:
+ *   static inline void merge_commit_merge_callback(merge_commit_t* rx_mc, merge_commit_t* tx_mc);
+ * It is included by merge-commit.c, so the callback can be inlined into the slot handler.
+ * Without it, the app has to provide merge_commit_merge_callback as a regular function. */
+//#define MERGE_COMMIT_CALLBACK_HEADER "my-merge.h"
+
+/* Disable to compile out the election and handover round handling
+ * for apps that never change the initiator */
+#ifndef MERGE_COMMIT_WITH_ELECTION
+#define MERGE_COMMIT_WITH_ELECTION 1
+#endif
+
 
 #ifndef MERGE_COMMIT_ADVANCED_STATS
 #define MERGE_COMMIT_ADVANCED_STATS 0
@@ -93,7 +93,15 @@
 #define NETSTACK_CONF_RADIO cooja_radio_driver
 #define UIP_CONF_IP_FORWARD           1
 
-#else /* NETSTACK_CONF_WITH_IPV4 */
+#elif NETSTACK_CONF_WITH_CHAOS /* NETSTACK_CONF_WITH_IPV4 */
+
+/* Network setup for Chaos */
+#define NETSTACK_CONF_NETWORK chaosnet_driver
+#define NETSTACK_CONF_MAC chaosmac_driver
+#define NETSTACK_CONF_RDC nordc_driver
+#define NETSTACK_CONF_RADIO cooja_radio_driver
+
+#else /* NETSTACK_CONF_WITH_IPV4, NETSTACK_CONF_WITH_CHAOS */
 
 /* Network setup for Rime */
 #define NETSTACK_CONF_NETWORK rime_driver
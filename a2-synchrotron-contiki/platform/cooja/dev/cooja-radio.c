@@ -216,6 +216,43 @@ radio_send(const void *payload, unsigned short payload_len)
   return RADIO_TX_OK;
 }
 /*---------------------------------------------------------------------------*/
+int
+radio_send_immediately(const void *payload, unsigned short payload_len)
+{
+  int radiostate = simRadioHWOn;
+
+  if(payload_len > COOJA_RADIO_BUFSIZE) {
+    return RADIO_TX_ERR;
+  }
+  if(payload_len == 0) {
+    return RADIO_TX_ERR;
+  }
+  if(simOutSize > 0) {
+    return RADIO_TX_ERR;
+  }
+  simRadioHWOn = 1;
+
+  /* Copy packet data to temporary storage */
+  memcpy(simOutDataBuffer, payload, payload_len);
+  simOutSize = payload_len;
+
+  /* Transmit. The caller may run in an rtimer task: keep the process
+   * thread from running while we wait for Cooja */
+  while(simOutSize > 0) {
+    simProcessRunValue = 1;
+    cooja_mt_yield();
+  }
+
+  simRadioHWOn = radiostate;
+  return RADIO_TX_OK;
+}
+/*---------------------------------------------------------------------------*/
+void
+radio_flushrx(void)
+{
+  simInSize = 0;
+}
+/*---------------------------------------------------------------------------*/
 static int
 prepare_packet(const void *data, unsigned short len)
 {
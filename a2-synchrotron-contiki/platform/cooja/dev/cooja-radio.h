@@ -70,5 +70,19 @@ radio_signal_strength_current(void);
 int
 radio_LQI(void);
 
+/**
+ * Send a packet right away, without turnaround time and CCA.
+ * Used by synchronous protocols that schedule their transmissions
+ * themselves, e.g. Chaos.
+ */
+int
+radio_send_immediately(const void *payload, unsigned short payload_len);
+
+/**
+ * Drop a received packet that has not been read.
+ */
+void
+radio_flushrx(void);
+
 
 #endif /* COOJA_RADIO_H_ */
@@ -107,4 +107,15 @@ rtimer_arch_now(void)
   return simCurrentTime;
 }
 /*---------------------------------------------------------------------------*/
-
+rtimer_clock_t
+rtimer_arch_now_fast(void)
+{
+  return rtimer_arch_now();
+}
+/*---------------------------------------------------------------------------*/
+rtimer_clock_t
+rtimer_arch_peek(void)
+{
+  return simCurrentTime;
+}
+/*---------------------------------------------------------------------------*/
@@ -39,8 +39,60 @@
 #define RTIMER_ARCH_SECOND CLOCK_CONF_SECOND
 
 rtimer_clock_t rtimer_arch_now(void);
+rtimer_clock_t rtimer_arch_now_fast(void);
+rtimer_clock_t rtimer_arch_peek(void);
 int rtimer_arch_check(void);
 int rtimer_arch_pending(void);
 rtimer_clock_t rtimer_arch_next(void);
 
+/*
+ * Very high resolution (VHT) and DCO clocks used by Chaos.
+ * A Cooja mote has only the simulation clock, so all three clocks are the
+ * rtimer clock (1 ms) and the DCO sync is a no-op. Time stamps are read
+ * with rtimer_arch_peek(), which does not yield to Cooja; busy-waits use
+ * RTIMER_NOW() or RTIMER_NOW_FAST(), which both let the simulation time
+ * advance.
+ */
+#define RT_VHT_PHI 1
+#define CLOCK_PHI 1
+#define DCO_VHT_PHI 1
+
+typedef uint32_t vht_clock_t;
+
+typedef struct vht_rtimer_dco_clockt {
+  vht_clock_t vht;
+  rtimer_clock_t rtimer;
+  rtimer_clock_t dco;
+} vht_rtimer_dco_clockt_t;
+
+#define DCO_NOW() (rtimer_arch_peek())
+#define VHT_NOW() ((vht_clock_t)rtimer_arch_peek())
+#define RTIMER_DCO_SYNC()
+#define VHT_RTIMER_DCO_NOW() (vht_to_vht_rtimer_dco(VHT_NOW()))
+#define VHT_DCO_NOW() (rtimer_arch_peek())
+
+#define RTIMER_TO_DCO(X) ((rtimer_clock_t)(X))
+#define DCO_TO_RTIMER(X) ((rtimer_clock_t)(X))
+#define RTIMER_TO_DCO_U32(X) ((uint32_t)(X))
+#define RTIMER_TO_US(X) ((uint32_t)((X) * (1000000uL / RTIMER_ARCH_SECOND)))
+
+#define RTIMER_LT(a,b) RTIMER_CLOCK_LT(a,b)
+#define DCO_LT(a,b) RTIMER_CLOCK_LT(a,b)
+#define VHT_LT(a,b) ((int32_t)((a)-(b)) < 0)
+#define VHT_TO_RTIMER(X) ((rtimer_clock_t)(X))
+#define RTIMER_TO_VHT(X) ((vht_clock_t)(X))
+#define DCO_TO_VHT(X) ((vht_clock_t)(X))
+#define VHT_TO_DCO(X) ((rtimer_clock_t)(X))
+#define VHT_TO_DCO_PART(X) ((rtimer_clock_t)0)
+#define RTIMER_DCO_TO_VHT(X,Y) ((vht_clock_t)(X))
+#define VHT_TO_US(X) ((X) * (1000000uL / RTIMER_ARCH_SECOND))
+#define DCO_TO_US(X) ((X) * (1000000uL / RTIMER_ARCH_SECOND))
+
+static inline vht_rtimer_dco_clockt_t
+vht_to_vht_rtimer_dco(vht_clock_t vht)
+{
+  vht_rtimer_dco_clockt_t vht_rtimer_dco = {vht, VHT_TO_RTIMER(vht), 0};
+  return vht_rtimer_dco;
+}
+
 #endif /* RTIMER_ARCH_H_ */
@@ -84,12 +84,14 @@ simlog(const char *message)
   simLoggedFlag = 1;
 }
 /*-----------------------------------------------------------------------------------*/
+#if LOG_CONF_ENABLED
 void
 log_message(const char *part1, const char *part2)
 {
   simlog(part1);
   simlog(part2);
 }
+#endif /* LOG_CONF_ENABLED */
 /*-----------------------------------------------------------------------------------*/
 static void
 doInterfaceActionsBeforeTick(void)
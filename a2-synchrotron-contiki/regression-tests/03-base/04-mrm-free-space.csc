@@ -0,0 +1,116 @@
+<?xml version="1.0" encoding="UTF-8"?>
+<simconf>
+  <project EXPORT="discard">[APPS_DIR]/mrm</project>
+  <project EXPORT="discard">[APPS_DIR]/mspsim</project>
+  <project EXPORT="discard">[APPS_DIR]/avrora</project>
+  <project EXPORT="discard">[APPS_DIR]/serial_socket</project>
+  <project EXPORT="discard">[APPS_DIR]/collect-view</project>
+  <project EXPORT="discard">[APPS_DIR]/powertracker</project>
+  <simulation>
+    <title>MRM free space</title>
+    <randomseed>123456</randomseed>
+    <motedelay_us>1000000</motedelay_us>
+    <radiomedium>
+      org.contikios.mrm.MRM
+      <obstacles />
+    </radiomedium>
+    <events>
+      <logoutput>40000</logoutput>
+    </events>
+  </simulation>
+  <plugin>
+    org.contikios.cooja.plugins.ScriptRunner
+    <plugin_config>
+      <script>/* Compares the free space fast path of the MRM channel model
+ * with the ray tracer, for several parameter settings */
+TIMEOUT(10000, log.log("mismatches: " + mismatches + "\n"));
+
+GENERATE_MSG(1000, "check");
+YIELD_THEN_WAIT_UNTIL(msg.equals("check"));
+
+cm = sim.getRadioMedium().getChannelModel();
+paramClass = cm.getClass().getClassLoader().loadClass("org.contikios.mrm.ChannelModel$Parameter");
+function param(name) {
+  return java.lang.Enum.valueOf(paramClass, name);
+}
+
+settings = [
+  [],
+  [["rt_fspl_on_total_length", java.lang.Boolean.FALSE]],
+  [["rt_disallow_direct_path", java.lang.Boolean.TRUE]],
+  [["bg_noise_var", new java.lang.Double(0)], ["system_gain_var", new java.lang.Double(0)]],
+  [["rx_sensitivity", new java.lang.Double(-70)], ["frequency", new java.lang.Double(868)]]
+];
+txPowers = [0, -5, 1.5];
+interferences = [-java.lang.Double.MAX_VALUE, -90];
+
+fromX = 10;
+fromY = -20;
+count = 0;
+toX = java.lang.reflect.Array.newInstance(java.lang.Double.TYPE, 200);
+toY = java.lang.reflect.Array.newInstance(java.lang.Double.TYPE, 200);
+for (x = -40; x &lt;= 60; x += 12.5) {
+  for (y = -70; y &lt;= 30; y += 10) {
+    toX[count] = x;
+    toY[count] = y;
+    count++;
+  }
+}
+toX[count] = fromX;
+toY[count] = fromY;
+count++;
+probability = java.lang.reflect.Array.newInstance(java.lang.Double.TYPE, count);
+signalStrength = java.lang.reflect.Array.newInstance(java.lang.Double.TYPE, count);
+
+function same(a, b) {
+  return a == b || (isNaN(a) &amp;&amp; isNaN(b));
+}
+
+mismatches = 0;
+for (s = 0; s &lt; settings.length; s++) {
+  saved = [];
+  for (p = 0; p &lt; settings[s].length; p++) {
+    saved.push(cm.getParameterValue(param(settings[s][p][0])));
+    cm.setParameterValue(param(settings[s][p][0]), settings[s][p][1]);
+  }
+  if (!cm.isFreeSpace()) {
+    log.log("setting " + s + ": not free space\n");
+    log.testFailed();
+  }
+
+  for (t = 0; t &lt; txPowers.length; t++) {
+    for (i = 0; i &lt; interferences.length; i++) {
+      cm.getFreeSpaceProbabilities(fromX, fromY, txPowers[t], toX, toY, count,
+          interferences[i], probability, signalStrength);
+      for (r = 0; r &lt; count; r++) {
+        expected = cm.getProbability(fromX, fromY, txPowers[t], toX[r], toY[r], interferences[i]);
+        if (!same(expected[0], probability[r]) || !same(expected[1], signalStrength[r])) {
+          log.log("setting " + s + ", tx " + txPowers[t] + ", interference " + interferences[i] +
+              ", to " + toX[r] + "," + toY[r] + ": " + expected[0] + "/" + expected[1] +
+              " != " + probability[r] + "/" + signalStrength[r] + "\n");
+          mismatches++;
+        }
+      }
+    }
+  }
+
+  for (p = 0; p &lt; settings[s].length; p++) {
+    cm.setParameterValue(param(settings[s][p][0]), saved[p]);
+  }
+}
+
+if (mismatches == 0) {
+  log.testOK();
+} else {
+  log.log("mismatches: " + mismatches + "\n");
+  log.testFailed();
+}</script>
+      <active>true</active>
+    </plugin_config>
+    <width>600</width>
+    <z>0</z>
+    <height>700</height>
+    <location_x>267</location_x>
+    <location_y>1</location_y>
+  </plugin>
+</simconf>
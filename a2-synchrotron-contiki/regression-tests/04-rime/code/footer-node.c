@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2012, Thingsquare, www.thingsquare.com.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#include "contiki.h"
+#include "net/rime/broadcast.h"
+
+#include "sys/node-id.h"
+
+#include <stdio.h>
+
+/* Odd nodes broadcast numbered frames of different lengths, even nodes
+ * print every frame they receive with the RSSI and LQI of its footer */
+#define FRAMES 20
+/*---------------------------------------------------------------------------*/
+PROCESS(footer_node_process, "Footer node");
+AUTOSTART_PROCESSES(&footer_node_process);
+/*---------------------------------------------------------------------------*/
+static void
+broadcast_recv(struct broadcast_conn *c, const linkaddr_t *from)
+{
+  uint8_t *data = packetbuf_dataptr();
+  int i;
+
+  printf("rx %d:", packetbuf_datalen());
+  for(i = 0; i < packetbuf_datalen(); i++) {
+    printf(" %02x", data[i]);
+  }
+  printf(" rssi %d lqi %d\n",
+         (int16_t)packetbuf_attr(PACKETBUF_ATTR_RSSI),
+         packetbuf_attr(PACKETBUF_ATTR_LINK_QUALITY));
+}
+static const struct broadcast_callbacks broadcast_call = {broadcast_recv};
+static struct broadcast_conn broadcast;
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(footer_node_process, ev, data)
+{
+  static struct etimer et;
+  static uint8_t seqno;
+  static uint8_t buf[FRAMES * 3];
+  int i;
+
+  PROCESS_EXITHANDLER(broadcast_close(&broadcast);)
+
+  PROCESS_BEGIN();
+
+  broadcast_open(&broadcast, 129, &broadcast_call);
+
+  for(seqno = 0; seqno < FRAMES; seqno++) {
+    etimer_set(&et, CLOCK_SECOND);
+    PROCESS_WAIT_UNTIL(etimer_expired(&et));
+    if(node_id & 1) {
+      for(i = 0; i <= seqno * 3; i++) {
+        buf[i] = seqno + i;
+      }
+      packetbuf_copyfrom(buf, seqno * 3 + 1);
+      broadcast_send(&broadcast);
+    }
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -5,6 +5,7 @@ import org.contikios.cooja.*;
 import org.contikios.cooja.plugins.skins.VanetVisualizerSkin;
 import org.contikios.cooja.plugins.vanet.config.VanetConfig;
 import org.contikios.cooja.plugins.vanet.log.Logger;
+import org.contikios.cooja.plugins.vanet.log.WaitStatistics;
 import org.contikios.cooja.plugins.vanet.world.World;
 
 import java.util.Observable;
@@ -92,6 +93,7 @@ public class Vanet extends VisPlugin {
         simulation.invokeSimulationThread(new Runnable() {
             public void run() {
                 simulation.stopSimulation();
+                WaitStatistics.report(simulation.getSimulationTimeMillis());
                 Logger.flush();
                 VanetVisualizerSkin.waitForImages();
                 simulation.getCooja().doQuit(false, 0);
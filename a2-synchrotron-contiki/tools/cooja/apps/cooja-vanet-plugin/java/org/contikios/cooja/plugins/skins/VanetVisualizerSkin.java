@@ -38,12 +38,13 @@ import java.awt.image.ImageObserver;
 import java.io.File;
 import java.io.IOException;
 import java.io.InputStream;
-import java.util.ArrayList;
-import java.util.HashSet;
+import java.util.List;
 import java.util.Map;
-import java.util.Set;
+import java.util.concurrent.ConcurrentLinkedQueue;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.Semaphore;
 import java.util.concurrent.TimeUnit;
 
 import org.apache.log4j.Logger;
@@ -69,6 +70,8 @@ import org.contikios.cooja.plugins.vanet.world.World;
 import org.contikios.cooja.plugins.vanet.world.physics.Vector2D;
 
 import javax.imageio.ImageIO;
+import javax.imageio.ImageWriter;
+import javax.imageio.stream.ImageOutputStream;
 import javax.swing.*;
 
 /**
@@ -87,15 +90,34 @@ public class VanetVisualizerSkin implements VisualizerSkin {
 
     private boolean showTileReservations = false;
 
+    private static final Stroke LINK_STROKE = new BasicStroke(4);
+    private static final Stroke PLATOON_STROKE = new BasicStroke(5);
+
+    // grid and intersections, rendered again only if the network, the canvas size or the viewport changes
+    private BufferedImage staticLayer;
+    private TransportNetwork staticLayerNetwork;
+    private Point staticLayerOrigin;
+    private Point staticLayerUnit;
+
     private static String screenExportDir;
+    private static int screenExportIndex = -1;
     private static Simulation simulation;
 
+    // at most EXPORT_FRAMES captured frames wait for the encoders, the simulation blocks if they fall behind
+    private static final int EXPORT_THREADS = 2;
+    private static final int EXPORT_FRAMES = 4;
 
     private static ExecutorService executorService;
+    private static final Semaphore exportFrames = new Semaphore(EXPORT_FRAMES);
+    private static final ConcurrentLinkedQueue<BufferedImage> freeFrames = new ConcurrentLinkedQueue<>();
+    private static final ThreadLocal<ImageWriter> jpegWriter =
+            ThreadLocal.withInitial(() -> ImageIO.getImageWritersByFormatName("jpg").next());
 
     public VanetVisualizerSkin() {
         img = loadFromFile("img/intersection-big.png");
-        executorService = Executors.newFixedThreadPool(1);
+        if (executorService == null || executorService.isShutdown()) {
+            executorService = Executors.newFixedThreadPool(EXPORT_THREADS);
+        }
     }
 
     private BufferedImage loadFromFile(String path) {
@@ -110,23 +132,23 @@ public class VanetVisualizerSkin implements VisualizerSkin {
 
     public void paintBeforeMotes(Graphics g) {
 
-        render1mBackgroundGrid(g);
-
         World world = Vanet.world;
+        TransportNetwork transportNetwork = world != null ? world.getTransportNetwork() : null;
+
+        paintStaticLayer(g, transportNetwork);
 
         if (world != null) {
 
             drawPlatoonConnections(g, world);
 
-
-            TransportNetwork transportNetwork = world.getTransportNetwork();
-
             int width = transportNetwork.getWidth();
             int height = transportNetwork.getHeight();
             for(int y = 0; y < height; ++y) {
                 for(int x = 0; x < width; ++x) {
                     Intersection intersection = transportNetwork.getIntersection(x, y);
-                    renderIntersection(g, intersection);
+                    if (intersection instanceof TrafficLightAwareIntersection) {
+                        renderTrafficLights(g, (TrafficLightAwareIntersection) intersection);
+                    }
                 }
             }
 
@@ -135,7 +157,47 @@ public class VanetVisualizerSkin implements VisualizerSkin {
         }
     }
 
+    private void paintStaticLayer(Graphics g, TransportNetwork transportNetwork) {
+        int width = visualizer.getWidth();
+        int height = visualizer.getHeight();
+        if (width <= 0 || height <= 0) {
+            return;
+        }
+
+        // two points are enough to detect panning and zooming
+        Point origin = visualizer.transformPositionToPixel(0, 0, 0);
+        Point unit = visualizer.transformPositionToPixel(1000 * Vanet.SCALE, 1000 * Vanet.SCALE, 0);
 
+        if (staticLayer == null || staticLayer.getWidth() != width || staticLayer.getHeight() != height ||
+                staticLayerNetwork != transportNetwork || !origin.equals(staticLayerOrigin) || !unit.equals(staticLayerUnit)) {
+
+            if (staticLayer == null || staticLayer.getWidth() != width || staticLayer.getHeight() != height) {
+                staticLayer = new BufferedImage(width, height, BufferedImage.TYPE_INT_ARGB);
+            }
+            Graphics2D sg = staticLayer.createGraphics();
+            sg.setComposite(AlphaComposite.Clear);
+            sg.fillRect(0, 0, width, height);
+            sg.setComposite(AlphaComposite.SrcOver);
+            sg.setFont(g.getFont());
+
+            render1mBackgroundGrid(sg);
+
+            if (transportNetwork != null) {
+                for(int y = 0; y < transportNetwork.getHeight(); ++y) {
+                    for(int x = 0; x < transportNetwork.getWidth(); ++x) {
+                        renderIntersection(sg, transportNetwork.getIntersection(x, y));
+                    }
+                }
+            }
+            sg.dispose();
+
+            staticLayerNetwork = transportNetwork;
+            staticLayerOrigin = origin;
+            staticLayerUnit = unit;
+        }
+
+        g.drawImage(staticLayer, 0, 0, null);
+    }
 
 
     private void renderIntersection(Graphics g, Intersection intersection) {
@@ -164,35 +226,6 @@ public class VanetVisualizerSkin implements VisualizerSkin {
             }
         });
 
-        if (intersection instanceof TrafficLightAwareIntersection) {
-
-            Map<Lane, Integer> states = ((TrafficLightAwareIntersection) intersection).getTrafficLightStates(simulation.getSimulationTimeMillis());
-            intersection.getStartLanes().forEach(
-                l -> {
-                    Vector2D sp = l.getStartPos();
-                    Vector2D ep = l.getEndPos();
-
-                    float r = 0.1f * (float) Vanet.SCALE;
-
-                    Color color = Color.RED;
-                    Integer state = states.get(l);
-
-                    if (state == TrafficLightAwareIntersection.PHASE_GREEN) {
-                        color = Color.GREEN;
-                    } else if (state == TrafficLightAwareIntersection.PHASE_YELLOW) {
-                        color = Color.YELLOW;
-                    }
-
-                    Vector2D p = Vector2D.diff(ep, sp);
-                    p.normalize();
-                    p.rotate(Math.PI/4.0);
-                    p.scale(Vanet.SCALE * Math.sqrt(0.5) * 0.5);
-                    p.add(ep);
-                    drawCircle(g, p, r, color);
-                }
-            );
-        }
-
         /*FontMetrics fm = g.getFontMetrics();
         intersection.getLanes().forEach(
             l -> {
@@ -229,6 +262,32 @@ public class VanetVisualizerSkin implements VisualizerSkin {
         );*/
     }
 
+    private void renderTrafficLights(Graphics g, TrafficLightAwareIntersection intersection) {
+        Map<Lane, Integer> states = intersection.getTrafficLightStates(simulation.getSimulationTimeMillis());
+        float r = 0.1f * (float) Vanet.SCALE;
+
+        for (Lane l : ((Intersection) intersection).getStartLanes()) {
+            Vector2D sp = l.getStartPos();
+            Vector2D ep = l.getEndPos();
+
+            Color color = Color.RED;
+            Integer state = states.get(l);
+
+            if (state == TrafficLightAwareIntersection.PHASE_GREEN) {
+                color = Color.GREEN;
+            } else if (state == TrafficLightAwareIntersection.PHASE_YELLOW) {
+                color = Color.YELLOW;
+            }
+
+            Vector2D p = Vector2D.diff(ep, sp);
+            p.normalize();
+            p.rotate(Math.PI/4.0);
+            p.scale(Vanet.SCALE * Math.sqrt(0.5) * 0.5);
+            p.add(ep);
+            drawCircle(g, p, r, color);
+        }
+    }
+
 
     private void render1mBackgroundGrid(Graphics g) {
         /* Background grid every X meters */
@@ -293,7 +352,7 @@ public class VanetVisualizerSkin implements VisualizerSkin {
                     continue;
                 }
 
-                ArrayList<Vector2D> wps = v.getWaypoints();
+                List<Vector2D> wps = v.getWaypoints();
 
                 for (int i = 0; i < wps.size(); ++i) {
 
@@ -405,77 +464,39 @@ public class VanetVisualizerSkin implements VisualizerSkin {
 
     private void drawPlatoonConnections(Graphics g, World world) {
 
-        Set<OrderAwareVehicle> checked = new HashSet<>();
-
-        world.getVehicles().stream().filter(OrderAwareVehicle.class::isInstance).forEach(
-            pv -> checked.add((OrderAwareVehicle)pv)
-        );
-
-        /*if (visualizer.getSelectedMotes().size() == 0) {
-            return;
-        }
-
-        ArrayList<OrderAwareVehicle> toCheck = new ArrayList<>();
+        Graphics2D g2 = (Graphics2D) g;
 
+        Stroke initialStroke = g2.getStroke();
 
-        for (Mote mote: visualizer.getSelectedMotes()) {
-            VehicleInterface v = world.getVehicle(mote);
-            if (v instanceof OrderAwareVehicle) {
-                toCheck.add((OrderAwareVehicle)v);
+        for (VehicleInterface v : world.getVehicles()) {
+            if (!(v instanceof OrderAwareVehicle)) {
+                continue;
             }
-        }
-
-        while(toCheck.size() > 0) {
-            OrderAwareVehicle v = toCheck.remove(0);
-
-            if (!checked.contains(v)) {
-                checked.add(v);
-
-                OrderAwareVehicle pred = v.getPlatoonPredecessor();
-                if (pred != null) {
-                    if (!checked.contains(pred)) {
-                        toCheck.add(pred);
-                    }
-                }
-
-                OrderAwareVehicle succ = v.getPlatoonSuccessor();
-                if (succ != null) {
-                    if (!checked.contains(succ)) {
-                        toCheck.add(succ);
-                    }
-                }
+            OrderAwareVehicle pv = (OrderAwareVehicle) v;
+            OrderAwareVehicle pred = pv.getPredecessor();
+            if (pred == null) {
+                continue;
             }
-        }*/
 
-        Graphics2D g2 = (Graphics2D) g;
-
-        Stroke initialStroke = g2.getStroke();
+            Vector2D p = pv.getBody().getCenter();
+            Vector2D endPos = pred.getBody().getCenter();
+            Point lineStart = visualizer.transformPositionToPixel(p.getX(), p.getY(), 0);
+            Point lineEnd = visualizer.transformPositionToPixel(endPos.getX(), endPos.getY(), 0);
 
-        checked.forEach(
-            pv -> {
-                if (pv.getPredecessor() != null) {
-                    Vector2D p = pv.getBody().getCenter();
-                    Vector2D endPos = pv.getPredecessor().getBody().getCenter();
-                    Point lineStart = visualizer.transformPositionToPixel(p.getX(), p.getY(), 0);
-                    Point lineEnd = visualizer.transformPositionToPixel(endPos.getX(), endPos.getY(), 0);
-
-
-                    g2.setStroke(new BasicStroke(4));
-                    g2.setColor(Color.LIGHT_GRAY);
-
-                    // we mark same platoons with another color and more width
-                    if (pv instanceof PlatoonAwareVehicle && ((PlatoonAwareVehicle) pv).getPlatoon() != null) {
-                        if (pv.getPredecessor() instanceof PlatoonAwareVehicle &&
-                            ((PlatoonAwareVehicle) pv.getPredecessor()).getPlatoon() == ((PlatoonAwareVehicle) pv).getPlatoon()) {
-                            g2.setStroke(new BasicStroke(5));
-                            g2.setColor(Color.BLUE);
-                        }
-                    }
+            g2.setStroke(LINK_STROKE);
+            g2.setColor(Color.LIGHT_GRAY);
 
-                    g2.drawLine(lineStart.x, lineStart.y, lineEnd.x, lineEnd.y);
+            // we mark same platoons with another color and more width
+            if (pv instanceof PlatoonAwareVehicle && ((PlatoonAwareVehicle) pv).getPlatoon() != null) {
+                if (pred instanceof PlatoonAwareVehicle &&
+                    ((PlatoonAwareVehicle) pred).getPlatoon() == ((PlatoonAwareVehicle) pv).getPlatoon()) {
+                    g2.setStroke(PLATOON_STROKE);
+                    g2.setColor(Color.BLUE);
                 }
             }
-        );
+
+            g2.drawLine(lineStart.x, lineStart.y, lineEnd.x, lineEnd.y);
+        }
 
         g2.setStroke(initialStroke);
     }
@@ -566,37 +587,61 @@ public class VanetVisualizerSkin implements VisualizerSkin {
 
     public static void setScreenExportDir(String screenExportDir) {
         VanetVisualizerSkin.screenExportDir = screenExportDir;
+        VanetVisualizerSkin.screenExportIndex = -1;
     }
 
     public static void saveImage(long ms) {
         if (VanetVisualizerSkin.screenExportDir != null && VanetVisualizerSkin.screenExportDir.length() > 0 && visualizer != null && canvas != null) {
             JPanel paintPane = canvas;
             visualizer.setSize(768+12,768+54);
-            BufferedImage image = new BufferedImage(paintPane.getWidth(), paintPane.getHeight(), BufferedImage.TYPE_INT_RGB);
+
+            // wait for a free frame if the encoders fall behind
+            exportFrames.acquireUninterruptibly();
+            BufferedImage image = freeFrames.poll();
+            if (image == null || image.getWidth() != paintPane.getWidth() || image.getHeight() != paintPane.getHeight()) {
+                image = new BufferedImage(paintPane.getWidth(), paintPane.getHeight(), BufferedImage.TYPE_INT_RGB);
+            }
             Graphics2D g = image.createGraphics();
             paintPane.printAll(g);
             g.dispose();
 
             File directory = new File(VanetVisualizerSkin.screenExportDir);
-            if (!directory.exists()){
-                directory.mkdirs();
+            if (screenExportIndex < 0) {
+                if (!directory.exists()){
+                    directory.mkdirs();
+                }
+                String[] existing = directory.list();
+                screenExportIndex = existing != null ? existing.length : 0;
             }
 
-            File f = new File(directory, String.format("img_%06d.jpg", directory.list().length));
+            File f = new File(directory, String.format("img_%06d.jpg", screenExportIndex++));
 
             // Use an own thread for this, since this is very io abusive ;)
+            final BufferedImage frame = image;
             Runnable r = new Runnable() {
                 @Override
                 public void run() {
-                    try {
-                        ImageIO.write(image, "JPG", f);
+                    ImageWriter writer = jpegWriter.get();
+                    try (ImageOutputStream out = ImageIO.createImageOutputStream(f)) {
+                        writer.setOutput(out);
+                        writer.write(frame);
                         System.out.println(f.getAbsoluteFile());
                     } catch (IOException exp) {
                         exp.printStackTrace();
+                    } finally {
+                        writer.reset();
+                        freeFrames.offer(frame);
+                        exportFrames.release();
                     }
                 }
             };
-            executorService.submit(r);
+            try {
+                executorService.submit(r);
+            } catch (RejectedExecutionException e) {
+                // the encoders were already shut down, the frame is not written
+                freeFrames.offer(frame);
+                exportFrames.release();
+            }
         }
     }
 
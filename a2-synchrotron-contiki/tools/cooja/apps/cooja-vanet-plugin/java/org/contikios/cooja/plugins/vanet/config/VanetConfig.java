@@ -65,7 +65,15 @@ public class VanetConfig {
     right_turn_rate,          // rate for right turns at the intersection
     timeout,                  // timeout for the simulation
     chaos_initiator_timeout,  // timeout for the chaos network creation as a new initiator
-    chaos_max_platoon_size;   // The maximum size for chaos platoons
+    chaos_max_platoon_size,   // The maximum size for chaos platoons
+    chaos_pre_admission,      // join the network of the next intersection while still driving towards it
+    public_transport_rate,    // rate of public transport vehicles (higher reservation priority)
+    emergency_vehicle_rate,   // rate of emergency vehicles (highest reservation priority)
+    traffic_light_control,    // traffic light controller: fixed / actuated / max pressure
+    traffic_light_min_green,  // minimum green time in ms of the actuated controllers
+    traffic_light_max_green,  // maximum green time in ms of the actuated controllers
+    traffic_light_gap,        // green ends after this time in ms without vehicles at the stop line (gap-out)
+    parallel_steps;           // run the sensors and the read-only part of the vehicle logic in parallel
 
     public static Object getDefaultValue(Parameter p) {
       switch (p) {
@@ -91,6 +99,22 @@ public class VanetConfig {
           return (Long) 5000L;
         case chaos_max_platoon_size:
           return 1;
+        case chaos_pre_admission:
+          return false;
+        case public_transport_rate:
+          return 0.0;
+        case emergency_vehicle_rate:
+          return 0.0;
+        case traffic_light_control:
+          return TransportNetwork.TRAFFIC_LIGHT_CONTROL_FIXED;
+        case traffic_light_min_green:
+          return (Long) 5000L;
+        case traffic_light_max_green:
+          return (Long) 30000L;
+        case traffic_light_gap:
+          return (Long) 3000L;
+        case parallel_steps:
+          return true;
       }
       throw new RuntimeException("Unknown default value: " + p);
     }
@@ -310,4 +334,36 @@ public class VanetConfig {
   public int getChaosMaxPlatoonSize() {
     return getParameterIntegerValue(Parameter.chaos_max_platoon_size);
   }
+
+  public boolean getChaosPreAdmission() {
+    return getParameterBooleanValue(Parameter.chaos_pre_admission);
+  }
+
+  public double getPublicTransportRate() {
+    return getParameterDoubleValue(Parameter.public_transport_rate);
+  }
+
+  public double getEmergencyVehicleRate() {
+    return getParameterDoubleValue(Parameter.emergency_vehicle_rate);
+  }
+
+  public int getTrafficLightControl() {
+    return getParameterIntegerValue(Parameter.traffic_light_control);
+  }
+
+  public long getTrafficLightMinGreen() {
+    return getParameterLongValue(Parameter.traffic_light_min_green);
+  }
+
+  public long getTrafficLightMaxGreen() {
+    return getParameterLongValue(Parameter.traffic_light_max_green);
+  }
+
+  public long getTrafficLightGap() {
+    return getParameterLongValue(Parameter.traffic_light_gap);
+  }
+
+  public boolean getParallelSteps() {
+    return getParameterBooleanValue(Parameter.parallel_steps);
+  }
 }
@@ -0,0 +1,237 @@
+package org.contikios.cooja.plugins.vanet.log;
+
+import org.contikios.cooja.plugins.vanet.world.World;
+
+import java.io.*;
+import java.nio.charset.StandardCharsets;
+import java.util.*;
+
+/**
+ * Decodes the binary slot trace of chaos-log.c (CHAOS_LOG_TRACE).
+ *
+ * Inside the simulation the lines arrive through the MessageProxy and are logged as "chaos-trace" events.
+ * For other runs the decoder can be started on a saved mote output:
+ * java -cp vanet.jar org.contikios.cooja.plugins.vanet.log.ChaosTraceDecoder [--timeline] log.txt
+ */
+public class ChaosTraceDecoder {
+
+    public static final String PREFIX = "CHAOS-TRACE";
+    public static final String STANDALONE_PREFIX = "#" + PREFIX + " ";
+
+    private static final byte VERSION = 'T';
+    private static final int HEADER_LEN = 5;
+    private static final int RECORD_LEN = 13;
+
+    // see chaos_state_t and chaos_rx_status_t in chaos.h
+    private static final String[] STATES = {"INI", "cRX", "cTX", "OFF", "sRX", "sTX"};
+    private static final String[] RX_STATES = {"rNA", "rOK", "SFD", "HDR", "CRC", "MIC", "ERR"};
+    private static final int CHAOS_RX_TIMEOUT = 7;
+
+    public static final String CSV_HEADER = "node, round, slot, channel, state, rx_status, sfd_delta, src, flag_progress, dropped";
+
+    public static class Record {
+        public int node;
+        public int dropped;
+        public int round;
+        public int slot;
+        public int channel;
+        public int state;
+        public int rxStatus;
+        public long sfdDelta;
+        public int src;
+        public int flagProgress;
+
+        public String getStateName() {
+            return state < STATES.length ? STATES[state] : "UNK";
+        }
+
+        public String getRxStatusName() {
+            if (rxStatus >= CHAOS_RX_TIMEOUT) {
+                return "rTO" + (rxStatus - CHAOS_RX_TIMEOUT);
+            }
+            return RX_STATES[rxStatus];
+        }
+
+        /* One character per slot for the timeline view */
+        public char getTimelineChar() {
+            if (state == 2 || state == 5) {
+                return rxStatus == 1 || rxStatus == 0 ? 'T' : 't';
+            } else if (state == 1 || state == 4) {
+                return rxStatus == 1 ? 'R' : 'x';
+            }
+            return '.';
+        }
+
+        public String toCsv() {
+            return String.format("%d, %d, %d, %d, %s, %s, %d, %d, %d, %d",
+                    node, round, slot, channel, getStateName(), getRxStatusName(), sfdDelta, src, flagProgress, dropped);
+        }
+    }
+
+    public static boolean supports(byte[] msg) {
+        return startsWith(msg, PREFIX.getBytes(StandardCharsets.ISO_8859_1));
+    }
+
+    /* Log an already unescaped message from the MessageProxy */
+    public static void log(byte[] msg) {
+        List<Record> records = decode(Arrays.copyOfRange(msg, PREFIX.length(), msg.length));
+        for (Record r: records) {
+            Logger.event("chaos-trace", World.getCurrentMS(), r.toCsv(), String.format("%06d", r.node));
+        }
+    }
+
+    /* Decode one unescaped line payload (without the prefix) */
+    public static List<Record> decode(byte[] data) {
+        List<Record> records = new ArrayList<>();
+
+        if (data.length < HEADER_LEN || data[0] != VERSION) {
+            return records;
+        }
+
+        int node = u16(data, 1);
+        int dropped = u16(data, 3);
+
+        for (int pos = HEADER_LEN; pos + RECORD_LEN <= data.length; pos += RECORD_LEN) {
+            Record r = new Record();
+            r.node = node;
+            r.dropped = dropped;
+            r.round = u16(data, pos);
+            r.slot = u16(data, pos + 2);
+            r.channel = data[pos + 4] & 0xFF;
+            r.state = (data[pos + 5] >> 4) & 0x0F;
+            r.rxStatus = data[pos + 5] & 0x0F;
+            r.sfdDelta = (int) ((u16(data, pos + 6) << 16) | u16(data, pos + 8)); // signed
+            r.src = u16(data, pos + 10);
+            r.flagProgress = data[pos + 12] & 0xFF;
+            records.add(r);
+        }
+        return records;
+    }
+
+    /* Inverse of the 0x11 escaping used by the motes, see MessageProxy */
+    public static byte[] unescape(byte[] source) {
+        ByteArrayOutputStream out = new ByteArrayOutputStream(source.length);
+        for (int i = 0; i < source.length; ++i) {
+            byte c = source[i];
+            if (c == 0x11) {
+                i++;
+                if (i < source.length) {
+                    c = source[i];
+                    if (c == 0x12) {
+                        c = 0x0A;
+                    } else if (c == 0x13) {
+                        c = 0x0D;
+                    } else if (c == 0x14) {
+                        c = 0x00;
+                    }
+                    out.write(c);
+                }
+            } else {
+                out.write(c);
+            }
+        }
+        return out.toByteArray();
+    }
+
+    private static int u16(byte[] data, int pos) {
+        return ((data[pos] & 0xFF) << 8) | (data[pos + 1] & 0xFF);
+    }
+
+    private static boolean startsWith(byte[] data, byte[] prefix) {
+        if (data.length < prefix.length) {
+            return false;
+        }
+        for (int i = 0; i < prefix.length; ++i) {
+            if (data[i] != prefix[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    private static int indexOf(byte[] data, byte[] pattern) {
+        outer:
+        for (int i = 0; i + pattern.length <= data.length; ++i) {
+            for (int j = 0; j < pattern.length; ++j) {
+                if (data[i + j] != pattern[j]) {
+                    continue outer;
+                }
+            }
+            return i;
+        }
+        return -1;
+    }
+
+    /* Decode all trace lines of a saved log, with either the standalone or the VANET prefix */
+    public static List<Record> decodeLog(InputStream in) throws IOException {
+        byte[][] prefixes = {
+                STANDALONE_PREFIX.getBytes(StandardCharsets.ISO_8859_1),
+                ("#VANET " + PREFIX).getBytes(StandardCharsets.ISO_8859_1)
+        };
+
+        List<Record> records = new ArrayList<>();
+        ByteArrayOutputStream line = new ByteArrayOutputStream();
+        int b;
+        do {
+            b = in.read();
+            if (b != -1 && b != '\n') {
+                line.write(b);
+                continue;
+            }
+            byte[] bytes = line.toByteArray();
+            line.reset();
+            for (byte[] prefix: prefixes) {
+                int start = indexOf(bytes, prefix);
+                if (start != -1) {
+                    records.addAll(decode(unescape(Arrays.copyOfRange(bytes, start + prefix.length, bytes.length))));
+                    break;
+                }
+            }
+        } while (b != -1);
+        return records;
+    }
+
+    /* One line per node and round, one character per slot */
+    public static void writeTimeline(List<Record> records, PrintStream out) {
+        Map<Integer, Map<Integer, StringBuilder>> lines = new TreeMap<>();
+        for (Record r: records) {
+            StringBuilder sb = lines.computeIfAbsent(r.node, k -> new TreeMap<>())
+                    .computeIfAbsent(r.round, k -> new StringBuilder());
+            while (sb.length() < r.slot) {
+                sb.append(' ');
+            }
+            if (sb.length() == r.slot) {
+                sb.append(r.getTimelineChar());
+            } else {
+                sb.setCharAt(r.slot, r.getTimelineChar());
+            }
+        }
+        lines.forEach((node, rounds) -> rounds.forEach(
+                (round, sb) -> out.println(String.format("%5d %5d |%s", node, round, sb))
+        ));
+    }
+
+    public static void main(String[] args) throws IOException {
+        boolean timeline = false;
+        String file = null;
+        for (String arg: args) {
+            if (arg.equals("--timeline")) {
+                timeline = true;
+            } else {
+                file = arg;
+            }
+        }
+
+        List<Record> records;
+        try (InputStream in = new BufferedInputStream(file != null ? new FileInputStream(file) : System.in)) {
+            records = decodeLog(in);
+        }
+
+        if (timeline) {
+            writeTimeline(records, System.out);
+        } else {
+            System.out.println(CSV_HEADER);
+            records.forEach(r -> System.out.println(r.toCsv()));
+        }
+    }
+}
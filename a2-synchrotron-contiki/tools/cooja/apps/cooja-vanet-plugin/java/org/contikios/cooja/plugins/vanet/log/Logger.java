@@ -18,6 +18,7 @@ public class Logger {
     public static void setLogDir(String logDir) {
         Logger.logDir = logDir;
         loggerInstance = null; // reset logger! TODO: This is not the nices way
+        WaitStatistics.reset();
     }
 
     public Logger() {
@@ -0,0 +1,109 @@
+package org.contikios.cooja.plugins.vanet.log;
+
+import org.contikios.cooja.Mote;
+import org.contikios.cooja.Simulation;
+import org.contikios.cooja.interfaces.Radio;
+
+import java.util.Observable;
+import java.util.Observer;
+
+/**
+ * Integrates the radio on, TX and RX times of a mote.
+ * Logged per Chaos round as "radio" and per reservation as "reservation-radio", so the energy can be correlated with the coordination.
+ */
+public class RadioDutyCycle implements Observer {
+
+    private final Simulation simulation;
+    private final Radio radio;
+    private final String idStr;
+
+    private long lastUpdateTime;
+    private boolean wasOn;
+    private boolean wasTransmitting;
+    private boolean wasReceiving;
+
+    // accumulated times in us
+    private long on = 0;
+    private long tx = 0;
+    private long rx = 0;
+
+    private long roundStartTime;
+    private long roundStartOn = 0;
+    private long roundStartTx = 0;
+    private long roundStartRx = 0;
+
+    private long requestStartTime = -1;
+    private long requestStartOn = 0;
+
+    public RadioDutyCycle(Mote mote, int id) {
+        this.simulation = mote.getSimulation();
+        this.radio = mote.getInterfaces().getRadio();
+        this.idStr = String.format("%06d", id);
+
+        lastUpdateTime = simulation.getSimulationTime();
+        roundStartTime = lastUpdateTime;
+        if (radio != null) {
+            readState();
+            radio.addObserver(this);
+        }
+    }
+
+    @Override
+    public void update(Observable o, Object arg) {
+        update();
+    }
+
+    private void update() {
+        long now = simulation.getSimulationTime();
+        long t = now - lastUpdateTime;
+        if (wasOn) {
+            on += t;
+        }
+        if (wasTransmitting) {
+            tx += t;
+        } else if (wasReceiving) {
+            rx += t;
+        }
+        lastUpdateTime = now;
+        if (radio != null) {
+            readState();
+        }
+    }
+
+    private void readState() {
+        wasOn = radio.isRadioOn();
+        wasTransmitting = radio.isTransmitting();
+        wasReceiving = wasOn && radio.isReceiving();
+    }
+
+    // the round of our mote has ended, log its radio times
+    public void endRound(long ms) {
+        update();
+        Logger.event("radio", ms, String.format("%d, %d, %d, %d",
+                lastUpdateTime - roundStartTime, on - roundStartOn, tx - roundStartTx, rx - roundStartRx), idStr);
+        roundStartTime = lastUpdateTime;
+        roundStartOn = on;
+        roundStartTx = tx;
+        roundStartRx = rx;
+    }
+
+    // a new reservation request was sent
+    public void startRequest() {
+        if (requestStartTime < 0) {
+            update();
+            requestStartTime = lastUpdateTime;
+            requestStartOn = on;
+        }
+    }
+
+    // the reservation was accepted, log the radio on time it took
+    public void endRequest(long ms, int tiles) {
+        if (requestStartTime < 0) {
+            return;
+        }
+        update();
+        Logger.event("reservation-radio", ms, String.format("%d, %d, %d",
+                tiles, lastUpdateTime - requestStartTime, on - requestStartOn), idStr);
+        requestStartTime = -1;
+    }
+}
@@ -0,0 +1,69 @@
+package org.contikios.cooja.plugins.vanet.log;
+
+import org.contikios.cooja.plugins.vanet.world.World;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.TreeSet;
+
+/**
+ * Collects the waiting times per approach lane.
+ * Every new sample is logged as "waits". The percentiles of the lanes with new samples are logged
+ * as "wait-percentiles" once per report period and on shutdown, so the last line per lane holds the values of the whole run.
+ */
+public class WaitStatistics {
+
+    public static final long REPORT_PERIOD_MS = 10000;
+
+    // intersection id and lane id -> sorted waiting times in ms
+    private static Map<String, List<Long>> waits = new HashMap<>();
+
+    // lanes with new samples since the last report
+    private static Set<String> changed = new TreeSet<>();
+    private static long nextReportMS = 0;
+
+    public static void reset() {
+        waits.clear();
+        changed.clear();
+        nextReportMS = 0;
+    }
+
+    public static void add(int intersectionId, int laneId, int priorityClass, long waitMS) {
+        long ms = World.getCurrentMS();
+        String key = String.format("%d, %d", intersectionId, laneId);
+
+        List<Long> sorted = waits.computeIfAbsent(key, k -> new ArrayList<>());
+        int pos = Collections.binarySearch(sorted, waitMS);
+        sorted.add(pos < 0 ? -pos-1 : pos, waitMS);
+
+        Logger.event("waits", ms, String.format("%s, %d, %d", key, priorityClass, waitMS), null);
+        changed.add(key);
+
+        if (ms >= nextReportMS) {
+            report(ms);
+        }
+    }
+
+    public static void report(long ms) {
+        for (String key: changed) {
+            List<Long> sorted = waits.get(key);
+            Logger.event("wait-percentiles", ms, String.format("%s, %d, %d, %d, %d",
+                    key, sorted.size(), percentile(sorted, 50), percentile(sorted, 95), percentile(sorted, 99)), null);
+        }
+        changed.clear();
+        nextReportMS = ms + REPORT_PERIOD_MS;
+    }
+
+    // nearest-rank percentile of an already sorted list
+    public static long percentile(List<Long> sorted, int p) {
+        if (sorted.isEmpty()) {
+            return 0;
+        }
+        int rank = (int) Math.ceil(p / 100.0 * sorted.size());
+        return sorted.get(Math.max(0, rank-1));
+    }
+}
@@ -1,9 +1,11 @@
 package org.contikios.cooja.plugins.vanet.transport_network;
 
 import org.contikios.cooja.plugins.Vanet;
+import org.contikios.cooja.plugins.vanet.transport_network.intersection.ActuatedTrafficLightIntersection;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.ChaosIntersection;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.Intersection;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.Lane;
+import org.contikios.cooja.plugins.vanet.transport_network.intersection.LaneDetector;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.TrafficLightIntersection;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.layout.IntersectionLayout;
 import org.contikios.cooja.plugins.vanet.world.World;
@@ -22,10 +24,18 @@ public class TransportNetwork {
     private Intersection[] intersections;
     private int numStartLanes;
 
+    // detectors of all start lanes, only used by actuated traffic lights
+    private Map<Lane, LaneDetector> laneDetectors = new HashMap<>();
+    private List<ActuatedTrafficLightIntersection> actuatedIntersections = new ArrayList<>();
+
     public static final int INTERSECTION_TYPE_DECENTRALIZED = 0;
     public static final int INTERSECTION_TYPE_TRAFFIC_LIGHTS = 1;
 
-    public TransportNetwork(int width, int height, int intersectionType) {
+    public static final int TRAFFIC_LIGHT_CONTROL_FIXED = 0;
+    public static final int TRAFFIC_LIGHT_CONTROL_ACTUATED = 1;
+    public static final int TRAFFIC_LIGHT_CONTROL_MAX_PRESSURE = 2;
+
+    public TransportNetwork(int width, int height, int intersectionType, int trafficLightControl) {
         this.width = width;
         this.height = height;
 
@@ -42,7 +52,11 @@ public class TransportNetwork {
             for(int x = 0; x < width; ++x) {
                 int id = y*width+x;
                 Intersection newIntersection = null;
-                if (intersectionType == INTERSECTION_TYPE_TRAFFIC_LIGHTS) {
+                if (intersectionType == INTERSECTION_TYPE_TRAFFIC_LIGHTS && trafficLightControl != TRAFFIC_LIGHT_CONTROL_FIXED) {
+                    ActuatedTrafficLightIntersection actuated = new ActuatedTrafficLightIntersection(id, new Vector2D(offsetX, offsetY), trafficLightControl);
+                    actuatedIntersections.add(actuated);
+                    newIntersection = actuated;
+                } else if (intersectionType == INTERSECTION_TYPE_TRAFFIC_LIGHTS) {
                     newIntersection = new TrafficLightIntersection(id, new Vector2D(offsetX, offsetY));
                 } else {
                     newIntersection = new ChaosIntersection(id, new Vector2D(offsetX, offsetY));
@@ -57,6 +71,33 @@ public class TransportNetwork {
         }
 
         this.numStartLanes = (int) Arrays.stream(intersections).flatMap(i -> i.getStartLanes().stream()).filter(Lane::isInitialStart).count();
+
+        for (Intersection i: intersections) {
+            i.initPaths();
+        }
+
+        // the lanes are final once all intersections are connected
+        if (!actuatedIntersections.isEmpty()) {
+            for (Intersection i: intersections) {
+                for (Lane l: i.getStartLanes()) {
+                    laneDetectors.computeIfAbsent(l, LaneDetector::new);
+                }
+            }
+            actuatedIntersections.forEach(i -> i.setDetectors(laneDetectors));
+        }
+    }
+
+    public Collection<LaneDetector> getLaneDetectors() {
+        return laneDetectors.values();
+    }
+
+    /**
+     * Updates the traffic light controllers, after the physics updated the detectors.
+     */
+    public void simulate(long ms) {
+        for (ActuatedTrafficLightIntersection i: actuatedIntersections) {
+            i.update(ms);
+        }
     }
 
     public int getNumStartLanes() {
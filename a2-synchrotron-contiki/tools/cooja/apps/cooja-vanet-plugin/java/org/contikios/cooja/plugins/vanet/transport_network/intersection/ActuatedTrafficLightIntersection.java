@@ -0,0 +1,210 @@
+package org.contikios.cooja.plugins.vanet.transport_network.intersection;
+
+import org.contikios.cooja.plugins.vanet.config.VanetConfig;
+import org.contikios.cooja.plugins.vanet.log.Logger;
+import org.contikios.cooja.plugins.vanet.transport_network.TransportNetwork;
+import org.contikios.cooja.plugins.vanet.world.World;
+import org.contikios.cooja.plugins.vanet.world.physics.Vector2D;
+
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * Traffic lights driven by the lane detectors instead of a fixed schedule.
+ * Each lane direction is one phase, served in the same order as the fixed schedule.
+ *
+ * A green phase lasts at least the minimum green. It then ends if another phase has demand and either
+ * no vehicle actuated the detectors of the phase for the gap time (gap-out) or the maximum green is reached (max-out).
+ * Without demand elsewhere the green rests on the current phase.
+ * In max-pressure mode a phase additionally ends as soon as another phase has a higher pressure, and the phase
+ * with the highest pressure is served next. The pressure of a phase is the sum over its lanes of the vehicles
+ * on the lane minus the mean of the vehicles on its downstream lanes.
+ */
+public class ActuatedTrafficLightIntersection extends TrafficLightIntersection {
+
+    private int control;
+    private long minGreenMS;
+    private long maxGreenMS;
+    private long gapMS;
+
+    private List<List<Lane>> phases = new ArrayList<>();
+    private Map<Lane, LaneDetector> detectors = Collections.emptyMap();
+
+    private int phase = 0;
+    private int signal = PHASE_GREEN;
+    private long signalSinceMS = 0;
+    private long greenSinceMS = 0;
+
+    private volatile Map<Lane, Integer> states = Collections.emptyMap();
+
+    public ActuatedTrafficLightIntersection(int id, Vector2D offset, int control) {
+        super(id, offset);
+        VanetConfig config = World.getConfig();
+        this.control = control;
+        this.minGreenMS = config.getTrafficLightMinGreen();
+        this.maxGreenMS = Math.max(minGreenMS, config.getTrafficLightMaxGreen());
+        this.gapMS = config.getTrafficLightGap();
+    }
+
+    /**
+     * Called by the network once all lanes are connected.
+     * The detectors of the downstream lanes belong to the neighbouring intersections.
+     */
+    public void setDetectors(Map<Lane, LaneDetector> detectors) {
+        this.detectors = detectors;
+
+        phases.clear();
+        for (int dir: PHASE_DIRECTIONS) {
+            List<Lane> lanes = new ArrayList<>();
+            for (Lane l: getStartLanes()) {
+                if (l.getDirection() == dir) {
+                    lanes.add(l);
+                }
+            }
+            if (!lanes.isEmpty()) {
+                phases.add(lanes);
+            }
+        }
+        phase = 0;
+        updateStates();
+    }
+
+    public void update(long ms) {
+        if (phases.isEmpty()) {
+            return;
+        }
+        long inSignal = ms - signalSinceMS;
+
+        if (signal == PHASE_GREEN) {
+            if (inSignal < minGreenMS || !hasDemand(phase, true)) {
+                return;
+            }
+            String reason = null;
+            if (inSignal >= maxGreenMS) {
+                reason = "max-out";
+            } else if (ms - getLastPresenceMS(phase) >= gapMS) {
+                reason = "gap-out";
+            } else if (control == TransportNetwork.TRAFFIC_LIGHT_CONTROL_MAX_PRESSURE &&
+                    getPressure(nextPhase()) > getPressure(phase)) {
+                reason = "pressure";
+            }
+            if (reason != null) {
+                Logger.event("signals", ms, String.format("%d, %d, %d, %s", getId(), phase, ms - greenSinceMS, reason), null);
+                setSignal(PHASE_YELLOW, ms);
+            }
+        } else if (signal == PHASE_YELLOW) {
+            if (inSignal >= YELLOW_PHASE_DURATION_MS) {
+                setSignal(PHASE_RED, ms);
+            }
+        } else {
+            // all red until the intersection is cleared
+            if (inSignal >= RED_PHASE_DURATION_MS) {
+                phase = nextPhase();
+                greenSinceMS = ms;
+                setSignal(PHASE_GREEN, ms);
+            }
+        }
+    }
+
+    @Override
+    public Map<Lane, Integer> getTrafficLightStates(long ms) {
+        return states;
+    }
+
+    private void setSignal(int signal, long ms) {
+        this.signal = signal;
+        this.signalSinceMS = ms;
+        updateStates();
+    }
+
+    private void updateStates() {
+        // replaced instead of modified, the visualizer reads the states from another thread
+        HashMap<Lane, Integer> newStates = new HashMap<>();
+        for (int i = 0; i < phases.size(); i++) {
+            for (Lane l: phases.get(i)) {
+                newStates.put(l, i == phase ? signal : PHASE_RED);
+            }
+        }
+        states = Collections.unmodifiableMap(newStates);
+    }
+
+    /**
+     * @return the phase to serve after the current one: the next other phase with demand in the fixed order,
+     * or the one with the highest pressure in max-pressure mode. The current phase if no other phase has demand.
+     */
+    private int nextPhase() {
+        if (control == TransportNetwork.TRAFFIC_LIGHT_CONTROL_MAX_PRESSURE) {
+            int best = phase;
+            double bestPressure = 0;
+            for (int i = 1; i < phases.size(); i++) {
+                int p = (phase + i) % phases.size();
+                double pressure = getPressure(p);
+                if (hasDemand(p, false) && (best == phase || pressure > bestPressure)) {
+                    best = p;
+                    bestPressure = pressure;
+                }
+            }
+            return best;
+        }
+        for (int i = 1; i < phases.size(); i++) {
+            int p = (phase + i) % phases.size();
+            if (hasDemand(p, false)) {
+                return p;
+            }
+        }
+        return phase;
+    }
+
+    // checks the lanes of p, or of all phases but p
+    private boolean hasDemand(int p, boolean otherPhases) {
+        for (int i = 0; i < phases.size(); i++) {
+            if ((i == p) == otherPhases) {
+                continue;
+            }
+            for (Lane l: phases.get(i)) {
+                LaneDetector d = detectors.get(l);
+                if (d != null && d.getOccupancy() > 0) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    private long getLastPresenceMS(int p) {
+        long last = -1;
+        for (Lane l: phases.get(p)) {
+            LaneDetector d = detectors.get(l);
+            if (d != null) {
+                last = Math.max(last, d.getLastPresenceMS());
+            }
+        }
+        return last;
+    }
+
+    private double getPressure(int p) {
+        double pressure = 0;
+        for (Lane l: phases.get(p)) {
+            LaneDetector d = detectors.get(l);
+            if (d == null) {
+                continue;
+            }
+            pressure += d.getOccupancy();
+
+            Collection<Lane> downstream = getPossibleLanes(l);
+            if (!downstream.isEmpty()) {
+                double sum = 0;
+                for (Lane out: downstream) {
+                    LaneDetector od = detectors.get(out);
+                    sum += od != null ? od.getOccupancy() : 0;
+                }
+                pressure -= sum / downstream.size();
+            }
+        }
+        return pressure;
+    }
+}
@@ -1,12 +1,35 @@
 package org.contikios.cooja.plugins.vanet.transport_network.intersection;
 
 
+import org.contikios.cooja.plugins.vanet.log.Logger;
+import org.contikios.cooja.plugins.vanet.world.World;
 import org.contikios.cooja.plugins.vanet.world.physics.Vector2D;
 
+import java.util.HashMap;
+import java.util.Map;
+
 public class ChaosIntersection extends Intersection {
 
+    // expected arrivals that did not join until this long after their ETA are dropped
+    private static final long ARRIVAL_EXPIRY = 30000;
+
+    // A vehicle that was accepted by an upstream network and is heading towards this intersection
+    public static class ExpectedArrival {
+        public final int vehicleId;
+        public final Lane lane;
+        public final long eta;
+
+        public ExpectedArrival(int vehicleId, Lane lane, long eta) {
+            this.vehicleId = vehicleId;
+            this.lane = lane;
+            this.eta = eta;
+        }
+    }
+
     long lastInitiatorRound = 0;
 
+    Map<Integer, ExpectedArrival> expectedArrivals = new HashMap<>();
+
     public ChaosIntersection(int id, Vector2D offset) {
         super(id, offset);
     }
@@ -18,4 +41,27 @@ public class ChaosIntersection extends Intersection {
     public void setLastInitiatorRound(long lastInitiatorRound) {
         this.lastInitiatorRound = lastInitiatorRound;
     }
+
+    // the upstream initiator forwards the vehicles it has accepted towards us
+    public void forwardArrival(ExpectedArrival arrival) {
+        expireArrivals(World.getCurrentMS());
+        expectedArrivals.put(arrival.vehicleId, arrival);
+    }
+
+    public ExpectedArrival getExpectedArrival(int vehicleId) {
+        return expectedArrivals.get(vehicleId);
+    }
+
+    // vehicles that were announced but never joined, e.g. because they did not get a slot in time
+    private void expireArrivals(long ms) {
+        expectedArrivals.values().removeIf(a -> a.eta + ARRIVAL_EXPIRY < ms);
+    }
+
+    // called as soon as the vehicle has joined our network
+    public void admitArrival(int vehicleId) {
+        ExpectedArrival arrival = expectedArrivals.remove(vehicleId);
+        if (arrival != null) {
+            Logger.event("arrivals", World.getCurrentMS(), String.format("%d, %d, %d, %d", getId(), vehicleId, arrival.eta, World.getCurrentMS()), null);
+        }
+    }
 }
@@ -74,6 +74,22 @@ public class Intersection {
         return layout.getPossibleLanes(id);
     }
 
+    /**
+     * Builds the paths through the intersection, called once all lanes are connected.
+     */
+    public void initPaths() {
+        layout.initPaths(this);
+    }
+
+    public WayPointPath getPath(Lane arrival, Lane departure) {
+        WayPointPath path = layout.getPath(arrival, departure);
+        if (path == null) {
+            // not connected yet
+            path = new WayPointPath(this, arrival, departure);
+        }
+        return path;
+    }
+
     public TiledMapHandler getMapHandler() {
         return mapHandler;
     }
@@ -17,6 +17,9 @@ public class Lane {
     protected Vector2D endPos;
     protected int endId;
 
+    // normalized direction, reset whenever a position is replaced
+    private Vector2D directionVector;
+
     public static final int STEPS_INTO_LANE = 3;
 
     static final int DIR_UP = 0;
@@ -40,6 +43,7 @@ public class Lane {
 
     public void setStartPos(Vector2D startPos) {
         this.startPos = startPos;
+        this.directionVector = null;
     }
 
     public int getStartId() {
@@ -64,6 +68,7 @@ public class Lane {
 
     public void setEndPos(Vector2D endPos) {
         this.endPos = endPos;
+        this.directionVector = null;
     }
 
     public int getEndId() {
@@ -74,10 +79,16 @@ public class Lane {
         this.endId = endId;
     }
 
+    /**
+     * @return the normalized direction, shared and thus not to be modified
+     */
     public Vector2D getDirectionVector() {
-        Vector2D dir = Vector2D.diff(endPos, startPos);
-        dir.normalize();
-        return dir;
+        if (directionVector == null) {
+            Vector2D dir = Vector2D.diff(endPos, startPos);
+            dir.normalize();
+            directionVector = dir;
+        }
+        return directionVector;
     }
 
     public int getDirection() {
@@ -0,0 +1,78 @@
+package org.contikios.cooja.plugins.vanet.transport_network.intersection;
+
+import org.contikios.cooja.plugins.Vanet;
+import org.contikios.cooja.plugins.vanet.world.World;
+import org.contikios.cooja.plugins.vanet.world.physics.Computation.LineIntersection;
+import org.contikios.cooja.plugins.vanet.world.physics.Physics;
+import org.contikios.cooja.plugins.vanet.world.physics.Sensor;
+import org.contikios.cooja.plugins.vanet.world.physics.Vector2D;
+
+/**
+ * Detector at the stop line of a lane.
+ * Counts the vehicles on the lane and remembers when a vehicle was last seen close to the stop line.
+ */
+public class LaneDetector implements Sensor {
+
+    // vehicles within this many tiles before the stop line actuate the detector
+    public static final double PRESENCE_LENGTH = 2.0;
+
+    private Lane lane;
+
+    // we start half a tile behind the stop line (like World.getFreePosition) and look against the driving direction
+    private Vector2D pos;
+    private Vector2D dir;
+    private double length;
+    private double presenceLength;
+
+    private int occupancy = 0;
+    private long lastPresenceMS = -1;
+
+    public LaneDetector(Lane lane) {
+        this.lane = lane;
+
+        dir = new Vector2D(lane.getDirectionVector());
+        pos = new Vector2D(dir);
+        pos.scale(0.5 * Vanet.SCALE);
+        pos.add(lane.getEndPos());
+        dir.scale(-1);
+
+        length = Vector2D.distance(lane.getStartPos(), lane.getEndPos()) + 0.5 * Vanet.SCALE;
+        presenceLength = (0.5 + PRESENCE_LENGTH) * Vanet.SCALE;
+    }
+
+    @Override
+    public void update(Physics physics, double delta) {
+        int count = 0;
+        boolean present = false;
+        for (LineIntersection i: physics.computeLineIntersections(pos, dir)) {
+            if (i.distance >= 0.0 && i.distance <= length) {
+                count++;
+                if (i.distance <= presenceLength) {
+                    present = true;
+                }
+            }
+        }
+        occupancy = count;
+        if (present) {
+            lastPresenceMS = World.getCurrentMS();
+        }
+    }
+
+    public Lane getLane() {
+        return lane;
+    }
+
+    /**
+     * @return number of vehicles on the lane
+     */
+    public int getOccupancy() {
+        return occupancy;
+    }
+
+    /**
+     * @return last time a vehicle was close to the stop line, -1 if never
+     */
+    public long getLastPresenceMS() {
+        return lastPresenceMS;
+    }
+}
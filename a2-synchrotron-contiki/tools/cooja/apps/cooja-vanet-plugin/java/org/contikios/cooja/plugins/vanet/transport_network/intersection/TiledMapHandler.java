@@ -57,6 +57,10 @@ public class TiledMapHandler {
             reserved.add(index);
         }
 
+        public void reserveTile(int index) {
+            reserved.add(index);
+        }
+
         public byte[] getByteIndices() {
 
             int[] temp = reserved.stream().mapToInt(Integer::intValue).toArray();
@@ -7,6 +7,13 @@ import java.util.Map;
 
 public class TrafficLightIntersection extends Intersection implements TrafficLightAwareIntersection {
 
+    protected static final long GREEN_PHASE_DURATION_MS = 9*1000;
+    protected static final long YELLOW_PHASE_DURATION_MS = 3*1000;
+    protected static final long RED_PHASE_DURATION_MS = 3*1000;
+
+    // the lane directions in the order they get green
+    protected static final int[] PHASE_DIRECTIONS = {Lane.DIR_RIGHT, Lane.DIR_LEFT, Lane.DIR_DOWN, Lane.DIR_UP};
+
     public TrafficLightIntersection(int id, Vector2D offset) {
         super(id, offset);
     }
@@ -28,9 +35,9 @@ public class TrafficLightIntersection extends Intersection implements TrafficLig
                 break;
         }
 
-        long greenPhaseDurationMS = 9*1000;
-        long yellowPhaseDurationMS = 3*1000;
-        long redPhaseDurationMS = 3*1000;
+        long greenPhaseDurationMS = GREEN_PHASE_DURATION_MS;
+        long yellowPhaseDurationMS = YELLOW_PHASE_DURATION_MS;
+        long redPhaseDurationMS = RED_PHASE_DURATION_MS;
 
         long overall = greenPhaseDurationMS+yellowPhaseDurationMS+redPhaseDurationMS;
         long phase = ms / overall;
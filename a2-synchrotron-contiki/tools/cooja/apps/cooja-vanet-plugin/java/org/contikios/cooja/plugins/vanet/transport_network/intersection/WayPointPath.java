@@ -0,0 +1,99 @@
+package org.contikios.cooja.plugins.vanet.transport_network.intersection;
+
+import org.contikios.cooja.plugins.vanet.world.physics.Vector2D;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+/**
+ * The waypoints from an arrival lane through the intersection into a departure lane.
+ * Built once per lane pair when the network is set up and shared by all vehicles taking that route,
+ * so neither the path nor its waypoints may be modified.
+ */
+public class WayPointPath {
+
+    private final Lane arrival;
+    private final Lane departure;
+    private final int turn;
+
+    private final List<Vector2D> waypoints;
+
+    // distance along the path from the stop line of the arrival lane to each waypoint
+    private final double[] arcLength;
+    // distance from the stop line to the end of the departure lane
+    private final double length;
+
+    // tile of the intersection map for each waypoint
+    private final int[] tiles;
+
+    public WayPointPath(Intersection intersection, Lane arrival, Lane departure) {
+        this.arrival = arrival;
+        this.departure = departure;
+        this.turn = arrival.computeTurn(departure);
+
+        ArrayList<Vector2D> points = arrival.getWayPoints(departure);
+        this.waypoints = Collections.unmodifiableList(points);
+
+        TiledMapHandler mapHandler = intersection.getMapHandler();
+        arcLength = new double[points.size()];
+        tiles = new int[points.size()];
+
+        double dist = 0;
+        Vector2D p = arrival.getEndPos();
+        for (int i = 0; i < points.size(); ++i) {
+            dist += Vector2D.distance(p, points.get(i));
+            p = points.get(i);
+            arcLength[i] = dist;
+            tiles[i] = mapHandler.posToIndex(p);
+        }
+        length = dist + Vector2D.distance(p, departure.getEndPos());
+    }
+
+    public Lane getArrival() {
+        return arrival;
+    }
+
+    public Lane getDeparture() {
+        return departure;
+    }
+
+    /**
+     * @return IntersectionLayout.TURN_LEFT, STRAIGHT or TURN_RIGHT
+     */
+    public int getTurn() {
+        return turn;
+    }
+
+    public List<Vector2D> getWaypoints() {
+        return waypoints;
+    }
+
+    public int size() {
+        return waypoints.size();
+    }
+
+    public double getArcLength(int index) {
+        return arcLength[index];
+    }
+
+    public double getLength() {
+        return length;
+    }
+
+    public int getTile(int index) {
+        return tiles[index];
+    }
+
+    /**
+     * @param index the next waypoint
+     * @param pos current position
+     * @return distance from pos over the remaining waypoints to the end of the departure lane
+     */
+    public double getRemainingDistance(int index, Vector2D pos) {
+        if (index >= waypoints.size()) {
+            return Vector2D.distance(pos, departure.getEndPos());
+        }
+        return Vector2D.distance(pos, waypoints.get(index)) + length - arcLength[index];
+    }
+}
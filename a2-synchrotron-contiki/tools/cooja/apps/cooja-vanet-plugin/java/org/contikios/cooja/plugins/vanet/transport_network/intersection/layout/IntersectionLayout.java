@@ -2,6 +2,7 @@ package org.contikios.cooja.plugins.vanet.transport_network.intersection.layout;
 
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.Intersection;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.Lane;
+import org.contikios.cooja.plugins.vanet.transport_network.intersection.WayPointPath;
 import org.contikios.cooja.plugins.vanet.world.physics.Vector2D;
 
 import java.util.*;
@@ -22,6 +23,8 @@ public abstract class IntersectionLayout {
     protected HashMap<Integer, Lane> startLanes = new HashMap<>();
     protected HashMap<Integer, Lane> endLanes = new HashMap<>();
     protected HashMap<Integer, Collection<Integer>> possibleDirs = new HashMap();
+    // arrival lane -> departure lane -> path, built once the lanes of the network are connected
+    protected HashMap<Lane, HashMap<Lane, WayPointPath>> paths = new HashMap<>();
     protected int nextLaneID = 1;
 
     public IntersectionLayout() {}
@@ -43,6 +46,22 @@ public abstract class IntersectionLayout {
 
 
 
+    public void initPaths(Intersection intersection) {
+        paths.clear();
+        for (Lane arrival: getStartLanes()) {
+            HashMap<Lane, WayPointPath> departures = new HashMap<>();
+            for (Lane departure: getPossibleLanes(arrival.getId(intersection))) {
+                departures.put(departure, new WayPointPath(intersection, arrival, departure));
+            }
+            paths.put(arrival, departures);
+        }
+    }
+
+    public WayPointPath getPath(Lane arrival, Lane departure) {
+        HashMap<Lane, WayPointPath> departures = paths.get(arrival);
+        return departures != null ? departures.get(departure) : null;
+    }
+
     public abstract void replaceLane(int originalId, Lane replacement);
 
     public abstract void init(Intersection intersection, Vector2D offset);
@@ -2,7 +2,7 @@ package org.contikios.cooja.plugins.vanet.vehicle;
 
 import org.contikios.cooja.Mote;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.Lane;
-import org.contikios.cooja.plugins.vanet.vehicle.physics.DirectionalDistanceSensor;
+import org.contikios.cooja.plugins.vanet.vehicle.physics.RayQuery;
 import org.contikios.cooja.plugins.vanet.world.World;
 import org.contikios.cooja.plugins.vanet.world.physics.Computation.LineIntersection;
 import org.contikios.cooja.plugins.vanet.world.physics.Vector2D;
@@ -18,6 +18,8 @@ abstract class BaseOrderVehicle extends BaseVehicle implements OrderAwareVehicle
 
     protected boolean predecessorWasMoving = false;
 
+    protected RayQuery predecessorQuery = new RayQuery();
+
     public OrderAwareVehicle getPredecessor() {
         return predecessor;
     }
@@ -60,11 +62,23 @@ abstract class BaseOrderVehicle extends BaseVehicle implements OrderAwareVehicle
     }
 
 
+    @Override
+    public void sense() {
+        super.sense();
+        if (state == STATE_QUEUING || state == STATE_MOVING) {
+            predecessorQuery.compute(world.getPhysics(), body.getCenter(), body.getDir(), body, getPredecessorSenseDist());
+        }
+    }
+
+    private double getPredecessorSenseDist() {
+        return calculateBreakDist(body.getVel().length())+2.5*body.getRadius();
+    }
+
     protected OrderAwareVehicle checkForPredecessor() {
 
-        double senseDist = calculateBreakDist(body.getVel().length())+2.5*body.getRadius();
+        double senseDist = getPredecessorSenseDist();
 
-        LineIntersection li = DirectionalDistanceSensor.computeNearestBodyCollisions(
+        LineIntersection li = predecessorQuery.get(
                 world.getPhysics(),
                 body.getCenter(),
                 body.getDir(),
@@ -5,16 +5,17 @@ import org.contikios.cooja.plugins.Vanet;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.Intersection;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.Lane;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.TiledMapHandler;
+import org.contikios.cooja.plugins.vanet.transport_network.intersection.WayPointPath;
 import org.contikios.cooja.plugins.vanet.vehicle.physics.DirectionalDistanceSensor;
 import org.contikios.cooja.plugins.vanet.vehicle.physics.VehicleBody;
 import org.contikios.cooja.plugins.vanet.world.World;
-import org.contikios.cooja.plugins.vanet.world.physics.Physics;
 import org.contikios.cooja.plugins.vanet.world.physics.Vector2D;
 
 import java.util.AbstractMap;
-import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.Collection;
+import java.util.Collections;
+import java.util.List;
 
 abstract class BaseVehicle implements VehicleInterface {
     protected VehicleBody body; // our physics model
@@ -24,6 +25,8 @@ abstract class BaseVehicle implements VehicleInterface {
 
     protected int state = STATE_INIT;
 
+    protected int priorityClass = PRIORITY_CLASS_DEFAULT;
+
     Vector2D startPos;
 
     protected World world;
@@ -54,6 +57,19 @@ abstract class BaseVehicle implements VehicleInterface {
         );
 
         distanceSensor = new DirectionalDistanceSensor(body);
+
+        double publicTransportRate = World.getConfig().getPublicTransportRate();
+        double emergencyRate = World.getConfig().getEmergencyVehicleRate();
+
+        // only draw if enabled, so the random sequence of other scenarios stays the same
+        if (publicTransportRate > 0 || emergencyRate > 0) {
+            double r = World.getRand().nextDouble();
+            if (r < emergencyRate) {
+                priorityClass = PRIORITY_CLASS_EMERGENCY;
+            } else if (r < emergencyRate + publicTransportRate) {
+                priorityClass = PRIORITY_CLASS_PUBLIC_TRANSPORT;
+            }
+        }
     }
 
 
@@ -96,6 +112,9 @@ abstract class BaseVehicle implements VehicleInterface {
         return id;
     }
 
+    public void sense() {
+    }
+
     public void step(double delta) {
         state = handleStates(state);
         Vector2D wantedPos = null;
@@ -129,11 +148,15 @@ abstract class BaseVehicle implements VehicleInterface {
             originalWP = waypoints.get(curWayPointIndex);
             nextWP = originalWP;
 
-            Vector2D originDir = Vector2D.diff(body.getCenter(), originalWP);
+            Vector2D center = body.getCenter();
+            double dirX = originalWP.getX() - center.getX();
+            double dirY = originalWP.getY() - center.getY();
+            double dirLength = Math.sqrt(dirX*dirX + dirY*dirY);
 
-            if (originDir.length() > 0) {
+            if (dirLength > 0) {
                 double threshold = 0.1*Vanet.SCALE;
-                originDir.normalize();
+                dirX /= dirLength;
+                dirY /= dirLength;
 
                 int i = curWayPointIndex+1;
 
@@ -145,7 +168,8 @@ abstract class BaseVehicle implements VehicleInterface {
                 }
                 while(i < max) {
                     Vector2D possWP = waypoints.get(i);
-                    double dist = Vector2D.distance(Physics.closestPointOnLine(body.getCenter(), originDir, possWP), possWP);
+                    // distance of the waypoint to the line from our center through the current waypoint
+                    double dist = Math.abs((possWP.getX() - center.getX())*dirY - (possWP.getY() - center.getY())*dirX);
                     if (dist < threshold) {
                         nextWP = possWP;
                         ++i;
@@ -163,13 +187,19 @@ abstract class BaseVehicle implements VehicleInterface {
     // Update the state, return value will be the next state
     protected abstract int handleStates(int state);
 
-    protected ArrayList<Vector2D> waypoints = new ArrayList<>();
+    protected WayPointPath path;
+    // the waypoints of the path, shared with all vehicles on the same route
+    protected List<Vector2D> waypoints = Collections.emptyList();
     protected int curWayPointIndex = 0;
 
-    public ArrayList<Vector2D> getWaypoints() {
+    public List<Vector2D> getWaypoints() {
         return waypoints;
     }
 
+    public WayPointPath getPath() {
+        return path;
+    }
+
     public int getCurWayPointIndex() {
         return curWayPointIndex;
     }
@@ -287,8 +317,9 @@ abstract class BaseVehicle implements VehicleInterface {
         // TODO: Use some planned path through multiple intersections
         targetLane = possibleLanes.stream().skip((int) (possibleLanes.size() * World.getRand().nextFloat())).findAny().get();
 
-        this.waypoints = lane.getWayPoints(targetLane);
         this.currentIntersection = lane.getEndIntersection();
+        this.path = currentIntersection.getPath(lane, targetLane);
+        this.waypoints = path.getWaypoints();
 
         currentLane = lane;
         startPos = lane.getEndPos();
@@ -302,6 +333,11 @@ abstract class BaseVehicle implements VehicleInterface {
 
     @Override
     public int getTurn() {
-        return currentLane.computeTurn(targetLane);
+        return path != null ? path.getTurn() : currentLane.computeTurn(targetLane);
+    }
+
+    @Override
+    public int getPriorityClass() {
+        return priorityClass;
     }
 }
\ No newline at end of file
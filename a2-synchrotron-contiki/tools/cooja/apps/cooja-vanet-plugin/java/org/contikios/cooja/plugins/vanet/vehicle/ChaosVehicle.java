@@ -2,10 +2,14 @@ package org.contikios.cooja.plugins.vanet.vehicle;
 
 import org.contikios.cooja.Mote;
 import org.contikios.cooja.plugins.Vanet;
+import org.contikios.cooja.plugins.vanet.log.ChaosTraceDecoder;
+import org.contikios.cooja.plugins.vanet.log.RadioDutyCycle;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.ChaosIntersection;
+import org.contikios.cooja.plugins.vanet.transport_network.intersection.Intersection;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.Lane;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.TiledMapHandler;
-import org.contikios.cooja.plugins.vanet.vehicle.physics.DirectionalDistanceSensor;
+import org.contikios.cooja.plugins.vanet.transport_network.intersection.WayPointPath;
+import org.contikios.cooja.plugins.vanet.vehicle.physics.RayQuery;
 import org.contikios.cooja.plugins.vanet.vehicle.platoon.ChaosPlatoon;
 import org.contikios.cooja.plugins.vanet.vehicle.platoon.Platoon;
 import org.contikios.cooja.plugins.vanet.vehicle.platoon.PlatoonAwareVehicle;
@@ -37,6 +41,7 @@ public class ChaosVehicle extends BaseOrderVehicle implements PlatoonAwareVehicl
 
     protected MessageProxy messageProxy; // used for communication with cooja motes
     protected ChaosStatsHandler chaosStatsHandler; // handle the stats of the chaos motes
+    protected RadioDutyCycle radioDutyCycle; // radio times of the chaos motes
 
     ChaosPlatoon platoon;
 
@@ -50,15 +55,43 @@ public class ChaosVehicle extends BaseOrderVehicle implements PlatoonAwareVehicl
     protected ChaosNetworkState chaosNetworkState;
     protected ChaosPlatoon chaosPlatoon;
 
+    // we are joining the network of the next intersection while still driving towards it
+    protected boolean preAdmitted = false;
+
+    // the class our mote currently uses for its reservation priority
+    protected int sentPriorityClass = PRIORITY_CLASS_DEFAULT;
+
+    // is there another car between us and the stop line?
+    protected RayQuery queueQuery = new RayQuery();
+
     public ChaosVehicle(World world, Mote m, int id) {
         super(world, m, id);
         messageProxy = new MessageProxy(m);
         chaosStatsHandler = new ChaosStatsHandler(id);
+        radioDutyCycle = new RadioDutyCycle(m, id);
         chaosNetworkState = new ChaosNetworkState();
         chaosPlatoon = new ChaosPlatoon(this, World.getConfig().getChaosMaxPlatoonSize());
         setPlatoon(chaosPlatoon);
     }
 
+    @Override
+    public void sense() {
+        super.sense();
+        if (state == STATE_QUEUING) {
+            queueQuery.compute(world.getPhysics(), body.getCenter(), getQueueDir(), body, getQueueDist());
+        }
+    }
+
+    private Vector2D getQueueDir() {
+        Vector2D dir = Vector2D.diff(startPos, body.getCenter());
+        dir.normalize();
+        return dir;
+    }
+
+    private double getQueueDist() {
+        return Vector2D.distance(startPos, body.getCenter())+0.5*Vanet.SCALE;
+    }
+
     public void step(double delta) {
         // handle messages first
         byte[] msg = null;
@@ -69,18 +102,18 @@ public class ChaosVehicle extends BaseOrderVehicle implements PlatoonAwareVehicl
             msg = messageProxy.receive();
         }
 
-        if (state == STATE_WAITING && this.currentIntersection instanceof ChaosIntersection) {
-            ChaosIntersection chaosIntersection = (ChaosIntersection) this.currentIntersection;
+        Intersection networkIntersection = getNetworkIntersection();
+        boolean mayCreateNetwork = state == STATE_WAITING || (preAdmitted && !chaosNetworkState.hasChaosIndex());
+
+        if (mayCreateNetwork && networkIntersection instanceof ChaosIntersection) {
+            ChaosIntersection chaosIntersection = (ChaosIntersection) networkIntersection;
 
             if (chaosIntersection.getLastInitiatorRound() + World.getConfig().getChaosInitiatorTimeout() <= World.getCurrentMS()) {
                 // first send the wanted channel
-                byte[] bytes = new byte[2];
-                bytes[0] = 'C';
-                bytes[1] = (byte)((currentIntersection.getId()+11)&0xFF);
-                messageProxy.send(bytes);
+                sendChannel(chaosIntersection);
 
                 // then send the network creation!
-                bytes = new byte[1];
+                byte[] bytes = new byte[1];
                 bytes[0] = 'I';
                 messageProxy.send(bytes);
 
@@ -96,22 +129,35 @@ public class ChaosVehicle extends BaseOrderVehicle implements PlatoonAwareVehicl
         return platoon != null && platoon.isHead(this);
     }
 
+    // the intersection whose network we are part of (or trying to join)
+    protected Intersection getNetworkIntersection() {
+        if (preAdmitted && state == STATE_LEFT) {
+            return targetLane.getEndIntersection();
+        }
+        return currentIntersection;
+    }
+
+    protected void sendChannel(Intersection intersection) {
+        byte[] bytes = new byte[2];
+        bytes[0] = 'C';
+        bytes[1] = (byte)((intersection.getId()+11)&0xFF);
+        messageProxy.send(bytes);
+    }
+
     // Update the state, return value will be the next state
     protected int handleStates(int state) {
 
         if (state == STATE_INITIALIZED) {
             // Change the channel to the one for the intersection
-            byte[] bytes = new byte[2];
-            bytes[0] = 'C';
-            bytes[1] = (byte)((currentIntersection.getId()+11)&0xFF);
-            messageProxy.send(bytes);
+            sendChannel(currentIntersection);
             return STATE_QUEUING;
         } else if (state == STATE_QUEUING) {
 
             updatePredecessor();
 
             // we always try to join the platoon in front of us
-            if (isPlatoonHead() && predecessor instanceof PlatoonAwareVehicle) {
+            // (unless we were pre-admitted, then we keep our own slot in the network)
+            if (!preAdmitted && isPlatoonHead() && predecessor instanceof PlatoonAwareVehicle) {
                 Platoon predPlatoon = ((PlatoonAwareVehicle) predecessor).getPlatoon();
 
                 if (predPlatoon != chaosPlatoon &&
@@ -141,15 +187,12 @@ public class ChaosVehicle extends BaseOrderVehicle implements PlatoonAwareVehicl
 
             boolean shouldJoin = false;
             // we check if there is no other car in front of us
-            Vector2D dir = Vector2D.diff(startPos, body.getCenter());
-            dir.normalize();
-
-            LineIntersection li = DirectionalDistanceSensor.computeNearestBodyCollisions(
+            LineIntersection li = queueQuery.get(
                     world.getPhysics(),
                     body.getCenter(),
-                    dir,
+                    getQueueDir(),
                     body,
-                    Vector2D.distance(startPos, body.getCenter())+0.5*Vanet.SCALE
+                    getQueueDist()
             );
 
             if (li != null) {
@@ -165,8 +208,11 @@ public class ChaosVehicle extends BaseOrderVehicle implements PlatoonAwareVehicl
             }
 
             if (shouldJoin) {
-                // and we try to join the chaos network
-                messageProxy.send("J".getBytes());
+                // and we try to join the chaos network, pre-admitted vehicles already did that
+                if (!preAdmitted) {
+                    messageProxy.send("J".getBytes());
+                }
+                preAdmitted = false;
                 return STATE_WAITING;
             }
         } else if (state == STATE_WAITING) {
@@ -226,13 +272,25 @@ public class ChaosVehicle extends BaseOrderVehicle implements PlatoonAwareVehicl
                     return STATE_LEFT;
                 } else {
                     initLane(targetLane);
-                    byte[] bytes = new byte[2];
-                    bytes[0] = 'C';
-                    bytes[1] = (byte)((currentIntersection.getId()+11)&0xFF);
-                    messageProxy.send(bytes);
+                    if (!preAdmitted) {
+                        sendChannel(currentIntersection);
+                    }
+
+                    if (World.getConfig().getChaosPreAdmission()) {
+                        // we start with our own platoon at the next intersection, joined if we were pre-admitted
+                        chaosPlatoon = new ChaosPlatoon(this, World.getConfig().getChaosMaxPlatoonSize());
+                        chaosPlatoon.setJoined(chaosNetworkState.hasChaosIndex());
+                        setPlatoon(chaosPlatoon);
+                    }
                     return STATE_QUEUING;
                 }
             } else {
+                if (!preAdmitted && mayPreAdmit()) {
+                    // the next network expects us, so we join it right away
+                    sendChannel(targetLane.getEndIntersection());
+                    messageProxy.send("J".getBytes());
+                    preAdmitted = true;
+                }
                 return STATE_LEFT;
             }
 
@@ -251,20 +309,27 @@ public class ChaosVehicle extends BaseOrderVehicle implements PlatoonAwareVehicl
                 currentRequest = wantedRequest;
                 messageProxy.send(currentRequest);
                 requestState = REQUEST_STATE_SENT;
+                radioDutyCycle.startRequest();
             }
         }
     }
 
     protected void requestReservation() {
 
+        updatePriorityClass();
+
         TiledMapHandler.PathHelper pathHandler = currentIntersection.getMapHandler().createPathHelper();
 
         // we always request the reservation for the whole platoon as a head
         // TODO: We should be able to determine the lowest waypoint and loop through the waypoints based on that value
         platoon.getMembers().forEach(
             v -> {
-                for(int i = Math.max(0, v.getCurWayPointIndex()-1); i < v.getWaypoints().size(); ++i) {
-                    pathHandler.reservePos(v.getWaypoints().get(i));
+                // the tiles of the path are known up front
+                WayPointPath p = v.getPath();
+                if (p != null) {
+                    for(int i = Math.max(0, v.getCurWayPointIndex()-1); i < p.size(); ++i) {
+                        pathHandler.reserveTile(p.getTile(i));
+                    }
                 }
             }
         );
@@ -280,6 +345,63 @@ public class ChaosVehicle extends BaseOrderVehicle implements PlatoonAwareVehicl
         }
     }
 
+    // the platoon reserves with the highest class of its members
+    protected void updatePriorityClass() {
+        int wantedClass = priorityClass;
+        for (PlatoonAwareVehicle m: platoon.getMembers()) {
+            wantedClass = Math.max(wantedClass, m.getPriorityClass());
+        }
+
+        if (wantedClass != sentPriorityClass) {
+            byte[] bytes = new byte[2];
+            bytes[0] = 'P';
+            bytes[1] = (byte) wantedClass;
+            messageProxy.send(bytes);
+            sentPriorityClass = wantedClass;
+        }
+    }
+
+    protected boolean mayPreAdmit() {
+        if (!World.getConfig().getChaosPreAdmission() || targetLane.isFinalEndLane() || chaosNetworkState.hasChaosIndex()) {
+            return false;
+        }
+        Intersection next = targetLane.getEndIntersection();
+        return next instanceof ChaosIntersection && ((ChaosIntersection) next).getExpectedArrival(getID()) != null;
+    }
+
+    // the platoon got accepted, so we announce its members to their next intersections
+    // members on the same lane stay a platoon there, so only its future head takes a slot in the next network
+    protected void forwardArrivals() {
+        if (!World.getConfig().getChaosPreAdmission()) {
+            return;
+        }
+        platoon.getMembers().forEach(
+            m -> {
+                if (m instanceof ChaosVehicle) {
+                    ((ChaosVehicle) m).forwardArrival(platoon);
+                }
+            }
+        );
+    }
+
+    protected void forwardArrival(ChaosPlatoon acceptedPlatoon) {
+        if (targetLane == null || targetLane.isFinalEndLane() || !(targetLane.getEndIntersection() instanceof ChaosIntersection)) {
+            return;
+        }
+
+        if (!acceptedPlatoon.announce(targetLane)) {
+            return;
+        }
+
+        // we estimate the arrival with the remaining path at full speed
+        double dist = path.getRemainingDistance(curWayPointIndex, body.getCenter());
+        long eta = World.getCurrentMS() + (long) (1000.0 * dist / MAX_SPEED);
+
+        ((ChaosIntersection) targetLane.getEndIntersection()).forwardArrival(
+                new ChaosIntersection.ExpectedArrival(getID(), targetLane, eta)
+        );
+    }
+
     private void prepareRemoval() {
         if (targetLane.isFinalEndLane()) {
             // we remove our body from the world and set ourself to an end position
@@ -294,22 +416,40 @@ public class ChaosVehicle extends BaseOrderVehicle implements PlatoonAwareVehicl
     protected void handleMessage(byte[] msg) {
         //System.out.println(new String(msg));
 
+        if (new String(msg).equals("round_end")) {
+            radioDutyCycle.endRound(World.getCurrentMS());
+        }
 
         if (chaosStatsHandler.supports(msg)) {
             chaosStatsHandler.handle(msg);
-        } else if (new String(msg).equals("is_initiator") && currentIntersection instanceof ChaosIntersection) {
-            ((ChaosIntersection) currentIntersection).setLastInitiatorRound(World.getCurrentMS());
+        } else if (ChaosTraceDecoder.supports(msg)) {
+            ChaosTraceDecoder.log(msg);
+        } else if (new String(msg).equals("is_initiator") && getNetworkIntersection() instanceof ChaosIntersection) {
+            ((ChaosIntersection) getNetworkIntersection()).setLastInitiatorRound(World.getCurrentMS());
         } else if (state == STATE_INIT && new String(msg).equals("init")) {
             init();
             state = STATE_INITIALIZED;
         } else if (state == STATE_LEAVING && new String(msg).equals("left")) {
             state = STATE_LEFT;
+            if (World.getConfig().getChaosPreAdmission()) {
+                // we may be pre-admitted to the next network, which needs a fresh index
+                chaosNetworkState.setChaosIndex(-1);
+            }
             platoon.setJoined(false);
             prepareRemoval();
-        } else if (state == STATE_WAITING && new String(msg).startsWith("joined")) {
+        } else if ((state == STATE_WAITING || preAdmitted) && new String(msg).startsWith("joined")) {
             int chaosIndex = msg["joined".length()]&0xFF;
             chaosNetworkState.setChaosIndex(chaosIndex);
-            platoon.setJoined(true);
+            // while still driving towards the next network our platoon is the one we left,
+            // the platoon for the next network is marked as joined once we get there
+            if (state != STATE_LEFT) {
+                platoon.setJoined(true);
+            }
+
+            Intersection networkIntersection = getNetworkIntersection();
+            if (networkIntersection instanceof ChaosIntersection) {
+                ((ChaosIntersection) networkIntersection).admitArrival(getID());
+            }
         } else if (state == STATE_LEFT && targetLane.isFinalEndLane() && new String(msg).equals("round_end")) {
             state = STATE_FINISHED; // finish and remove the vehicle!
         }
@@ -320,6 +460,8 @@ public class ChaosVehicle extends BaseOrderVehicle implements PlatoonAwareVehicl
         } else if (requestState == REQUEST_STATE_ACKNOWLEDGED && new String(msg).equals("accepted")) {
             if (Arrays.equals(wantedRequest, currentRequest)) {
                 requestState = REQUEST_STATE_ACCEPTED;
+                radioDutyCycle.endRequest(World.getCurrentMS(), currentRequest.length-1);
+                forwardArrivals();
             } else {
                 requestState = REQUEST_STATE_INIT;
             }
@@ -349,11 +491,19 @@ public class ChaosVehicle extends BaseOrderVehicle implements PlatoonAwareVehicl
         from.messageProxy = to.messageProxy;
         to.messageProxy = mp;
 
+        int sentPriorityClass = from.sentPriorityClass;
+        from.sentPriorityClass = to.sentPriorityClass;
+        to.sentPriorityClass = sentPriorityClass;
+
         // and chaos stats handlers
         ChaosStatsHandler statsHandler = from.chaosStatsHandler;
         from.chaosStatsHandler = to.chaosStatsHandler;
         to.chaosStatsHandler = statsHandler;
 
+        RadioDutyCycle dutyCycle = from.radioDutyCycle;
+        from.radioDutyCycle = to.radioDutyCycle;
+        to.radioDutyCycle = dutyCycle;
+
 
         int requestState = from.requestState;
         from.requestState = to.requestState;
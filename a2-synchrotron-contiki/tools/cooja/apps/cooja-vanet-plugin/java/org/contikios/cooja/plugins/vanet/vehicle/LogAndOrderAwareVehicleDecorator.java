@@ -1,16 +1,42 @@
 package org.contikios.cooja.plugins.vanet.vehicle;
 
+import org.contikios.cooja.plugins.vanet.log.WaitStatistics;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.Lane;
+import org.contikios.cooja.plugins.vanet.world.World;
 
 public class LogAndOrderAwareVehicleDecorator extends LogAwareVehicleDecorator implements OrderAwareVehicle {
 
     OrderAwareVehicle impl;
 
+    protected int lastState = STATE_INIT;
+    protected long queuingSince = -1;
+
     public LogAndOrderAwareVehicleDecorator(OrderAwareVehicle impl) {
         super(impl);
         this.impl = impl;
     }
 
+    @Override
+    public void step(double delta) {
+        super.step(delta);
+        int state = impl.getState();
+
+        // the wait at an intersection lasts from queuing until we may move
+        if (state == STATE_QUEUING && lastState != STATE_QUEUING) {
+            queuingSince = World.getCurrentMS();
+        } else if (state == STATE_MOVING && lastState != STATE_MOVING && queuingSince >= 0) {
+            Lane lane = impl.getStartLane();
+            WaitStatistics.add(
+                getCurrentIntersection().getId(),
+                lane.getId(getCurrentIntersection()),
+                getPriorityClass(),
+                World.getCurrentMS()-queuingSince
+            );
+            queuingSince = -1;
+        }
+        lastState = state;
+    }
+
     @Override
     public void setPredecessor(OrderAwareVehicle vehicle) {
         impl.setPredecessor(vehicle);
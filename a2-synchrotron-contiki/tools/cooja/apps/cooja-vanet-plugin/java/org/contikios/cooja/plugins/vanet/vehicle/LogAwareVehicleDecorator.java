@@ -3,13 +3,14 @@ package org.contikios.cooja.plugins.vanet.vehicle;
 import org.contikios.cooja.Mote;
 import org.contikios.cooja.plugins.vanet.log.Logger;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.Intersection;
+import org.contikios.cooja.plugins.vanet.transport_network.intersection.WayPointPath;
 import org.contikios.cooja.plugins.vanet.vehicle.physics.DirectionalDistanceSensor;
 import org.contikios.cooja.plugins.vanet.vehicle.physics.VehicleBody;
 import org.contikios.cooja.plugins.vanet.world.World;
 import org.contikios.cooja.plugins.vanet.world.physics.Vector2D;
 
-import java.util.ArrayList;
 import java.util.HashMap;
+import java.util.List;
 import java.util.Map;
 
 public class LogAwareVehicleDecorator implements VehicleInterface {
@@ -62,15 +63,25 @@ public class LogAwareVehicleDecorator implements VehicleInterface {
     }
 
     @Override
-    public ArrayList<Vector2D> getWaypoints() {
+    public List<Vector2D> getWaypoints() {
         return impl.getWaypoints();
     }
 
+    @Override
+    public WayPointPath getPath() {
+        return impl.getPath();
+    }
+
     @Override
     public int getCurWayPointIndex() {
         return impl.getCurWayPointIndex();
     }
 
+    @Override
+    public void sense() {
+        impl.sense();
+    }
+
     @Override
     public void step(double delta) {
         impl.step(delta);
@@ -117,4 +128,9 @@ public class LogAwareVehicleDecorator implements VehicleInterface {
     public int getTurn() {
         return impl.getTurn();
     }
+
+    @Override
+    public int getPriorityClass() {
+        return impl.getPriorityClass();
+    }
 }
\ No newline at end of file
@@ -2,12 +2,13 @@ package org.contikios.cooja.plugins.vanet.vehicle;
 
 import org.contikios.cooja.Mote;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.Intersection;
+import org.contikios.cooja.plugins.vanet.transport_network.intersection.WayPointPath;
 import org.contikios.cooja.plugins.vanet.vehicle.physics.DirectionalDistanceSensor;
 import org.contikios.cooja.plugins.vanet.vehicle.physics.VehicleBody;
 import org.contikios.cooja.plugins.vanet.world.World;
 import org.contikios.cooja.plugins.vanet.world.physics.Vector2D;
 
-import java.util.ArrayList;
+import java.util.List;
 
 public interface VehicleInterface {
 
@@ -24,18 +25,30 @@ public interface VehicleInterface {
     int REQUEST_STATE_SENT = 1;
     int REQUEST_STATE_ACKNOWLEDGED = 2;
     int REQUEST_STATE_ACCEPTED = 3;
+
+    // see intersection-priority.h
+    int PRIORITY_CLASS_DEFAULT = 0;
+    int PRIORITY_CLASS_PUBLIC_TRANSPORT = 1;
+    int PRIORITY_CLASS_EMERGENCY = 2;
     
     World getWorld();
     DirectionalDistanceSensor getDistanceSensor();
     VehicleBody getBody();
     int getState();
+
+    /**
+     * Read-only part of the step, run in parallel for all vehicles before step() is called in ID order.
+     * May only compute results for the vehicle itself, step() has to work without them.
+     */
+    void sense();
     void step(double delta);
 
     void destroy();
 
     int getID();
 
-    ArrayList<Vector2D> getWaypoints();
+    List<Vector2D> getWaypoints();
+    WayPointPath getPath();
     int getCurWayPointIndex();
 
     Vector2D getNextWaypoint();
@@ -44,4 +57,6 @@ public interface VehicleInterface {
     void setMote(Mote mote);
 
     int getTurn();
+
+    int getPriorityClass();
 }
\ No newline at end of file
@@ -4,13 +4,27 @@ import org.contikios.cooja.Mote;
 import org.contikios.cooja.plugins.vanet.transport_network.TransportNetwork;
 import org.contikios.cooja.plugins.vanet.vehicle.platoon.PlatoonAwareVehicle;
 import org.contikios.cooja.plugins.vanet.world.World;
+import org.contikios.cooja.plugins.vanet.world.physics.Body;
 import org.contikios.cooja.plugins.vanet.world.physics.Vector2D;
 
 import java.util.Collection;
 import java.util.HashMap;
+import java.util.IdentityHashMap;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.function.Consumer;
+import java.util.function.Predicate;
 
 public class VehicleManager {
-    private HashMap<Integer, VehicleInterface> vehicles = new HashMap<>();
+    // in the order of the IDs, which is the order the vehicles are stepped in
+    private LinkedHashMap<Integer, VehicleInterface> vehicles = new LinkedHashMap<>();
+
+    // indexes for the lookups of the collision callbacks and sensors, kept in sync with the vehicles
+    private HashMap<Integer, Mote> motes = new HashMap<>();
+    private IdentityHashMap<Mote, VehicleInterface> vehiclesByMote = new IdentityHashMap<>();
+    private IdentityHashMap<Body, VehicleInterface> vehiclesByBody = new IdentityHashMap<>();
+
     private World world;
 
     public static final int INIT_POS = -1000000;
@@ -32,15 +46,64 @@ public class VehicleManager {
         return this.vehicles.get(id);
     }
 
+    public Mote getMote(int id) {
+        return this.motes.get(id);
+    }
+
+    public VehicleInterface getVehicle(Mote m) {
+        return this.vehiclesByMote.get(m);
+    }
+
+    public VehicleInterface getVehicleByBody(Body body) {
+        return this.vehiclesByBody.get(body);
+    }
+
     public synchronized void removeVehicle(int id) {
-        if (vehicles.containsKey(id)) {
-            VehicleInterface v = vehicles.get(id);
+        VehicleInterface v = vehicles.remove(id);
+        if (v != null) {
+            unindex(v);
             v.destroy();
-            // we remove the vehicle as well
-            vehicles.remove(id);
         }
     }
 
+    /**
+     * Removes all vehicles matching the filter in a single pass over the vehicles.
+     * removedMote is called with the mote of each removed vehicle.
+     */
+    public synchronized void removeVehicles(Predicate<VehicleInterface> filter, Consumer<Mote> removedMote) {
+        Iterator<VehicleInterface> it = vehicles.values().iterator();
+        while (it.hasNext()) {
+            VehicleInterface v = it.next();
+            if (filter.test(v)) {
+                it.remove();
+                Mote m = unindex(v);
+                v.destroy();
+                removedMote.accept(m);
+            }
+        }
+    }
+
+    /**
+     * Swaps the motes of two vehicles in the indexes.
+     */
+    public synchronized void swapMotes(VehicleInterface a, VehicleInterface b) {
+        Mote ma = motes.get(a.getID());
+        Mote mb = motes.get(b.getID());
+        motes.put(a.getID(), mb);
+        motes.put(b.getID(), ma);
+        vehiclesByMote.put(mb, a);
+        vehiclesByMote.put(ma, b);
+    }
+
+    private Mote unindex(VehicleInterface v) {
+        Mote m = motes.remove(v.getID());
+        if (m != null) {
+            vehiclesByMote.remove(m);
+        }
+        vehiclesByBody.remove(v.getBody());
+        return m;
+    }
+
     public synchronized VehicleInterface createVehicle(Mote m) {
         int id = idCounter+1;
         idCounter++;
@@ -70,6 +133,9 @@ public class VehicleManager {
             new Vector2D(INIT_POS, INIT_POS)
         );
         vehicles.put(id, v);
+        motes.put(id, m);
+        vehiclesByMote.put(m, v);
+        vehiclesByBody.put(v.getBody(), v);
         return v;
     }
 
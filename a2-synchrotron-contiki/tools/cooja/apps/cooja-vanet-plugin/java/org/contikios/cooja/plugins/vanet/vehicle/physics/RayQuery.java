@@ -0,0 +1,43 @@
+package org.contikios.cooja.plugins.vanet.vehicle.physics;
+
+import org.contikios.cooja.plugins.vanet.world.physics.Body;
+import org.contikios.cooja.plugins.vanet.world.physics.Computation.LineIntersection;
+import org.contikios.cooja.plugins.vanet.world.physics.Physics;
+import org.contikios.cooja.plugins.vanet.world.physics.Vector2D;
+
+/**
+ * A nearest body query of a vehicle, computed ahead in the parallel sense phase of World.simulate.
+ * The result is only reused for the very same query while no body has moved, been added or been removed,
+ * so it is always the same as computing the query again.
+ */
+public class RayQuery {
+
+    private long version = -1;
+    private double posX;
+    private double posY;
+    private double dirX;
+    private double dirY;
+    private double maxLength;
+    private Body except;
+
+    private LineIntersection result;
+
+    public void compute(Physics physics, Vector2D pos, Vector2D dir, Body except, double maxLength) {
+        this.result = DirectionalDistanceSensor.computeNearestBodyCollisions(physics, pos, dir, except, maxLength);
+        this.version = physics.getVersion();
+        this.posX = pos.getX();
+        this.posY = pos.getY();
+        this.dirX = dir.getX();
+        this.dirY = dir.getY();
+        this.maxLength = maxLength;
+        this.except = except;
+    }
+
+    public LineIntersection get(Physics physics, Vector2D pos, Vector2D dir, Body except, double maxLength) {
+        if (version == physics.getVersion() && except == this.except && maxLength == this.maxLength &&
+                pos.getX() == posX && pos.getY() == posY && dir.getX() == dirX && dir.getY() == dirY) {
+            return result;
+        }
+        return DirectionalDistanceSensor.computeNearestBodyCollisions(physics, pos, dir, except, maxLength);
+    }
+}
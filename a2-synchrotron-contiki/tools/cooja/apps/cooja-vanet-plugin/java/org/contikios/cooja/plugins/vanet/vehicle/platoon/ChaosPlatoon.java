@@ -1,9 +1,12 @@
 package org.contikios.cooja.plugins.vanet.vehicle.platoon;
 
+import org.contikios.cooja.plugins.vanet.transport_network.intersection.Lane;
 import org.contikios.cooja.plugins.vanet.vehicle.ChaosVehicle;
 import org.contikios.cooja.plugins.vanet.vehicle.VehicleInterface;
 
+import java.util.HashSet;
 import java.util.Observable;
+import java.util.Set;
 
 public class ChaosPlatoon extends Platoon  {
 
@@ -13,6 +16,9 @@ public class ChaosPlatoon extends Platoon  {
 
     protected Observable observable = new Observable();
 
+    // the lanes towards the next intersections on which a member was already announced
+    protected Set<Lane> announcedLanes = new HashSet<>();
+
     public ChaosPlatoon(PlatoonAwareVehicle platoonAwareVehicle, int maxSize) {
         super(platoonAwareVehicle);
         this.maxSize = maxSize;
@@ -26,6 +32,11 @@ public class ChaosPlatoon extends Platoon  {
         this.joined = joined;
     }
 
+    // only the first member per lane is announced, the ones behind it queue up and join its platoon
+    public boolean announce(Lane lane) {
+        return announcedLanes.add(lane);
+    }
+
     public boolean isMoving() {
         return getHead().getState() > VehicleInterface.STATE_WAITING;
     }
@@ -4,6 +4,7 @@ import org.contikios.cooja.*;
 import org.contikios.cooja.interfaces.Position;
 import org.contikios.cooja.plugins.Vanet;
 import org.contikios.cooja.plugins.vanet.config.VanetConfig;
+import org.contikios.cooja.plugins.vanet.log.Logger;
 import org.contikios.cooja.plugins.vanet.transport_network.TransportNetwork;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.Lane;
 import org.contikios.cooja.plugins.vanet.transport_network.intersection.TiledMapHandler;
@@ -17,7 +18,6 @@ import org.contikios.cooja.plugins.vanet.world.physics.Physics;
 import org.contikios.cooja.plugins.vanet.world.physics.Vector2D;
 
 import java.util.*;
-import java.util.stream.Collectors;
 
 public class World {
 
@@ -35,9 +35,11 @@ public class World {
 
 
     private MoteType vehicleMoteType;
-    private Map<Integer, Mote> moteMap = new HashMap<>();
     private IDGenerator idGenerator;
 
+    // vehicles that left the network
+    private int finishedVehicles = 0;
+
     public World(Simulation simulation, Random rand, VanetConfig config) {
         inst = this; // initialize singleton
 
@@ -46,12 +48,15 @@ public class World {
 
         this.simulation = simulation;
         this.physics = new Physics();
-        this.transportNetwork = new TransportNetwork(config.getNetworkWidth(), config.getNetworkHeight(), config.getIntersectionType());
+        this.physics.setParallel(config.getParallelSteps());
+        this.transportNetwork = new TransportNetwork(config.getNetworkWidth(), config.getNetworkHeight(), config.getIntersectionType(), config.getTrafficLightControl());
 
         this.vehicleMoteType = simulation.getMoteType("vehicle");
         this.vehicleManager = new VehicleManager(this, config.getIntersectionType());
         this.idGenerator = new IDGenerator(1, 65535); // only allow ids between 1 and 2^16-1
 
+        this.transportNetwork.getLaneDetectors().forEach(physics::addSensor);
+
         // we remove all nodes in the beginning
         Arrays.stream(simulation.getMotes()).forEach(simulation::removeMote);
     }
@@ -87,28 +92,33 @@ public class World {
         // update sensors etc...
         this.physics.simulate(delta, currentMS);
 
-        // step through every vehicle logic and execute it
+        // the traffic lights react to the updated detectors
+        this.transportNetwork.simulate(currentMS);
+
+        // the read-only part of the vehicle logic runs in parallel, its results only depend on the state after the physics step
+        if (config.getParallelSteps()) {
+            vehicleCollection.parallelStream().forEach(VehicleInterface::sense);
+        }
+
+        // step through every vehicle logic and execute it, in ID order
         vehicleCollection.forEach(v -> v.step(delta));
 
         // step through every vehicle and update the position in the simulation
         vehicleCollection.forEach(this::writeBackPosition);
 
         // remove unwanted vehicles
-        vehicleCollection.stream()
-                .filter(v -> v.getState() == VehicleInterface.STATE_FINISHED)
-                .collect(Collectors.toList())
-                .forEach(this::removeVehicle);
+        vehicleManager.removeVehicles(v -> v.getState() == VehicleInterface.STATE_FINISHED, this::finishMote);
     }
 
     private void writeBackPosition(VehicleInterface v) {
-        Mote mote = moteMap.get(v.getID());
+        Mote mote = vehicleManager.getMote(v.getID());
         Position pos = mote.getInterfaces().getPosition();
         Vector2D center = v.getBody().getCenter();
         pos.setCoordinates(center.getX(), center.getY(), 0);
     }
 
     private void readPosition(VehicleInterface v) {
-        Mote mote = moteMap.get(v.getID());
+        Mote mote = vehicleManager.getMote(v.getID());
         Vector2D center = v.getBody().getCenter();
         Position pos = mote.getInterfaces().getPosition();
         center.setX(pos.getXCoordinate());
@@ -139,7 +149,7 @@ public class World {
 
 
     public Mote getMote(VehicleInterface v){
-        return moteMap.get(v.getID());
+        return vehicleManager.getMote(v.getID());
     }
 
     /**
@@ -158,8 +168,7 @@ public class World {
         //ma.getInterfaces().getMoteID().setMoteID(mb.getID());
         //mb.getInterfaces().getMoteID().setMoteID(tmpId);
 
-        moteMap.put(a.getID(), mb);
-        moteMap.put(b.getID(), ma);
+        vehicleManager.swapMotes(a, b);
 
         // we write back the positions of the vehicles
         writeBackPosition(a);
@@ -171,24 +180,27 @@ public class World {
     }
 
     public VehicleInterface getVehicle(Mote m) {
-        for (Map.Entry<Integer, Mote> entry : moteMap.entrySet()) {
-            if (Objects.equals(m, entry.getValue())) {
-                return this.vehicleManager.getVehicle(entry.getKey());
-            }
-        }
-        return null;
+        return vehicleManager.getVehicle(m);
     }
 
     public void initVehicle(Mote m) {
         VehicleInterface v = vehicleManager.createVehicle(m);
-        moteMap.put(v.getID(), m);
         writeBackPosition(v); // support initial position setting
     }
 
     public void removeVehicle(VehicleInterface v) {
-        Mote m = moteMap.get(v.getID());
-        moteMap.remove(v.getID());
+        Mote m = vehicleManager.getMote(v.getID());
         vehicleManager.removeVehicle(v.getID());
+        removeMote(m);
+    }
+
+    private void finishMote(Mote m) {
+        finishedVehicles++;
+        Logger.event("throughput", currentMS, String.valueOf(finishedVehicles), null);
+        removeMote(m);
+    }
+
+    private void removeMote(Mote m) {
         idGenerator.free(m.getID());
         simulation.removeMote(m);
     }
@@ -233,7 +245,6 @@ public class World {
     }
 
     public VehicleInterface getVehicleByPhysicsBody(Body body) {
-        return vehicleManager.getVehicleCollection().stream()
-                .filter(v -> v.getBody() == body).findAny().get();
+        return vehicleManager.getVehicleByBody(body);
     }
 }
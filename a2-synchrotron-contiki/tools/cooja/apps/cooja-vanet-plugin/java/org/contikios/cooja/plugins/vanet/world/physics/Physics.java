@@ -15,12 +15,28 @@ public class Physics {
     private ArrayList<Body> bodies = new ArrayList<>();
     private Collection<Sensor> sensors = new ArrayList<>();
 
+    // changes whenever a body moves, is added or is removed
+    private long version = 0;
+
+    // update the sensors in parallel, each sensor only writes its own state
+    private boolean parallel = false;
+
     public Physics() {
 
     }
 
+    public long getVersion() {
+        return version;
+    }
+
+    public void setParallel(boolean parallel) {
+        this.parallel = parallel;
+    }
+
     public void simulate(double delta, long ms) {
 
+        version++;
+
         // move the bodies based on their velocity
         for (Body body: bodies) {
             Vector2D vel = new Vector2D(body.getVel());
@@ -50,17 +66,24 @@ public class Physics {
             }
         }
 
-        sensors.forEach( s -> s.update(this, delta));
+        if (parallel) {
+            sensors.parallelStream().forEach( s -> s.update(this, delta));
+        } else {
+            sensors.forEach( s -> s.update(this, delta));
+        }
     }
 
     public void addBody(Body b) {
         if (!this.bodies.contains(b)) {
             this.bodies.add(b);
+            version++;
         }
     }
 
     public void removeBody(Body b) {
-        this.bodies.remove(b);
+        if (this.bodies.remove(b)) {
+            version++;
+        }
     }
 
 
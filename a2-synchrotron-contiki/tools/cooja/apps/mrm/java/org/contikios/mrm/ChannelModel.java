@@ -84,6 +84,7 @@ public class ChannelModel {
   private static double paramFSPL = 0;
   private boolean needToPrecalculateOutputPower = true;
   private static double paramOutputPower = 0;
+  private FreeSpaceParameters freeSpaceParameters = null;
 
   private ObstacleWorld myObstacleWorld = new ObstacleWorld();
 
@@ -437,6 +438,7 @@ public class ChannelModel {
     // Guessing we need to recalculate input to FSPL+Output power
     needToPrecalculateFSPL = true;
     needToPrecalculateOutputPower = true;
+    freeSpaceParameters = null;
 
     settingsObservable.setChangedAndNotify();
   }
@@ -1771,6 +1773,139 @@ public class ChannelModel {
     return new double[] { probReception, signalStrength };
   }
 
+  /**
+   * Calculates probability that a receiver at given destination receives
+   * a packet from a transmitter at given source, with omnidirectional antennas.
+   *
+   * @param fromX Source position X
+   * @param fromY Source position Y
+   * @param txPower Transmitter output power (dBm)
+   * @param toX Destination position X
+   * @param toY Destination position Y
+   * @param interference Current interference at destination (dBm)
+   * @return [Probability of reception, signal strength at destination]
+   * @see #getProbability(TxPair, double)
+   */
+  public double[] getProbability(final double fromX, final double fromY, final double txPower,
+      final double toX, final double toY, double interference) {
+    TxPair txPair = new TxPair() {
+      public double getFromX() { return fromX; }
+      public double getFromY() { return fromY; }
+      public double getToX() { return toX; }
+      public double getToY() { return toY; }
+      public double getTxPower() { return txPower; }
+      public double getTxGain() { return 0; }
+      public double getRxGain() { return 0; }
+    };
+    return getProbability(txPair, interference);
+  }
+
+  /**
+   * Parameters used by getFreeSpaceProbabilities(), read once from the
+   * parameter table.
+   */
+  private static class FreeSpaceParameters {
+    final double fspl;
+    final boolean fsplOnTotalLength;
+    final boolean directPath;
+    final double systemGainMean;
+    final double systemGainVar;
+    final double noiseMean;
+    final double noiseVar;
+    final double snrThreshold;
+    final double rxSensitivity;
+
+    FreeSpaceParameters(ChannelModel model) {
+      fspl = -32.44 -20*Math.log10(model.getParameterDoubleValue(Parameter.frequency) /*mhz*/);
+      fsplOnTotalLength = model.getParameterBooleanValue(Parameter.rt_fspl_on_total_length);
+      directPath = !model.getParameterBooleanValue(Parameter.rt_disallow_direct_path);
+      systemGainMean = model.getParameterDoubleValue(Parameter.system_gain_mean);
+      systemGainVar = model.getParameterDoubleValue(Parameter.system_gain_var);
+      noiseMean = model.getParameterDoubleValue(Parameter.bg_noise_mean);
+      noiseVar = model.getParameterDoubleValue(Parameter.bg_noise_var);
+      snrThreshold = model.getParameterDoubleValue(Parameter.snr_threshold);
+      rxSensitivity = model.getParameterDoubleValue(Parameter.rx_sensitivity);
+    }
+  }
+
+  /**
+   * @return True if there are no obstacles and no random values are applied,
+   * so that getFreeSpaceProbabilities() may be used instead of getProbability()
+   */
+  public boolean isFreeSpace() {
+    return myObstacleWorld.getNrObstacles() == 0 && !logMode &&
+        !getParameterBooleanValue(Parameter.apply_random);
+  }
+
+  /**
+   * Calculates the probabilities that receivers at the given destinations
+   * receive a packet from a transmitter at the given source, in a single pass
+   * over all destinations.
+   *
+   * Without obstacles the only ray path is the direct path, and the results
+   * are the same as those of getProbability() with omnidirectional antennas.
+   * Must only be used if isFreeSpace() is true.
+   *
+   * @param fromX Source position X
+   * @param fromY Source position Y
+   * @param txPower Transmitter output power (dBm)
+   * @param toX Destination positions X
+   * @param toY Destination positions Y
+   * @param count Number of destinations
+   * @param interference Current interference at destinations (dBm)
+   * @param probability Returns the probability of reception per destination
+   * @param signalStrength Returns the signal strength per destination
+   * @see #getProbability(TxPair, double)
+   */
+  public void getFreeSpaceProbabilities(double fromX, double fromY, double txPower,
+      double[] toX, double[] toY, int count, double interference,
+      double[] probability, double[] signalStrength) {
+    FreeSpaceParameters p = freeSpaceParameters;
+    if (p == null) {
+      p = freeSpaceParameters = new FreeSpaceParameters(this);
+    }
+
+    double noiseMean = p.noiseMean;
+    if (interference > noiseMean) {
+      noiseMean = interference;
+    }
+    double snrVariance = p.systemGainVar + p.noiseVar;
+
+    for (int i=0; i < count; i++) {
+      // Path gain of the direct path, as in getTransmissionData()
+      double totalPathGain = 0;
+      if (p.directPath) {
+        double w = toX[i] - fromX;
+        double h = toY[i] - fromY;
+        double distance = Math.sqrt(w*w+h*h);
+
+        double pathGain = 0;
+        if (p.fsplOnTotalLength || distance > 0) {
+          pathGain += Math.min(0.0, p.fspl - 20*Math.log10(distance/1000.0 /*km*/));
+        }
+        // Single path: no phase shift (cos(0) == 1)
+        totalPathGain += Math.pow(10, pathGain/10.0);
+      }
+      totalPathGain = 10*Math.log10(Math.abs(totalPathGain));
+
+      double signal = txPower + p.systemGainMean + 0 + totalPathGain;
+      double snrMean = signal - noiseMean;
+
+      // Probability of reception, as in getProbability()
+      double threshold = p.snrThreshold;
+      if (p.rxSensitivity > signal - snrMean &&
+          threshold < p.rxSensitivity + snrMean - signal) {
+        threshold = p.rxSensitivity + snrMean - signal;
+      }
+      if (snrVariance == 0) {
+        probability[i] = threshold - snrMean > 0 ? 0:1;
+      } else {
+        probability[i] = 1 - GaussianWrapper.cdfErrorAlgo(threshold, snrMean, Math.sqrt(snrVariance));
+      }
+      signalStrength[i] = signal;
+    }
+  }
+
   /**
    * Calculates and returns root-mean-square delay spread when given destination receives a packet from a transmitter at given source.
    * This method uses current parameters such as transmitted power,
@@ -1880,6 +2015,7 @@ public class ChannelModel {
     }
     needToPrecalculateFSPL = true;
     needToPrecalculateOutputPower = true;
+    freeSpaceParameters = null;
     settingsObservable.setChangedAndNotify();
     return true;
   }
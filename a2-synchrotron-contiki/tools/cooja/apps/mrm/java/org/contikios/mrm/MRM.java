@@ -91,6 +91,12 @@ public class MRM extends AbstractRadioMedium {
   private Random random = null;
   private ChannelModel currentChannelModel = null;
 
+  /* Receiver positions and results of the free space fast path */
+  private double[] toX = new double[0];
+  private double[] toY = new double[0];
+  private double[] recvProbs = new double[0];
+  private double[] recvSignals = new double[0];
+
   /**
    * Creates a new Multi-path Ray-tracing Medium (MRM).
    */
@@ -163,9 +169,33 @@ public class MRM extends AbstractRadioMedium {
     MRMRadioConnection newConnection = new MRMRadioConnection(sender);
     final Position senderPos = sender.getPosition();
 
+    /* Without obstacles, calculate all receive probabilities in one pass */
+    Radio[] radios = getRegisteredRadios();
+    boolean freeSpace = currentChannelModel.isFreeSpace() &&
+        !(sender instanceof DirectionalAntennaRadio);
+    if (freeSpace) {
+      if (toX.length < radios.length) {
+        toX = new double[radios.length];
+        toY = new double[radios.length];
+        recvProbs = new double[radios.length];
+        recvSignals = new double[radios.length];
+      }
+      for (int i=0; i < radios.length; i++) {
+        Position pos = radios[i].getPosition();
+        toX[i] = pos.getXCoordinate();
+        toY[i] = pos.getYCoordinate();
+      }
+      currentChannelModel.getFreeSpaceProbabilities(
+          senderPos.getXCoordinate(), senderPos.getYCoordinate(), sender.getCurrentOutputPower(),
+          toX, toY, radios.length,
+          -Double.MAX_VALUE /* TODO Include interference */,
+          recvProbs, recvSignals);
+    }
+
     /* TODO Cache potential destination in DGRM */
     /* Loop through all potential destinations */
-    for (Radio recv: getRegisteredRadios()) {
+    for (int i=0; i < radios.length; i++) {
+      Radio recv = radios[i];
       if (sender == recv) {
         continue;
       }
@@ -180,21 +210,27 @@ public class MRM extends AbstractRadioMedium {
       final Radio recvFinal = recv;
 
       /* Calculate receive probability */
-      TxPair txPair = new RadioPair() {
-        public Radio getFromRadio() {
-          return sender;
-        }
-        public Radio getToRadio() {
-          return recvFinal;
-        }
-      };
-      double[] probData = currentChannelModel.getProbability(
-          txPair,
-          -Double.MAX_VALUE /* TODO Include interference */
-      );
-
-      double recvProb = probData[0];
-      double recvSignalStrength = probData[1];
+      double recvProb;
+      double recvSignalStrength;
+      if (freeSpace && !(recv instanceof DirectionalAntennaRadio)) {
+        recvProb = recvProbs[i];
+        recvSignalStrength = recvSignals[i];
+      } else {
+        TxPair txPair = new RadioPair() {
+          public Radio getFromRadio() {
+            return sender;
+          }
+          public Radio getToRadio() {
+            return recvFinal;
+          }
+        };
+        double[] probData = currentChannelModel.getProbability(
+            txPair,
+            -Double.MAX_VALUE /* TODO Include interference */
+        );
+        recvProb = probData[0];
+        recvSignalStrength = probData[1];
+      }
       if (recvProb == 1.0 || random.nextDouble() < recvProb) {
         /* Yes, the receiver *may* receive this packet (it's strong enough) */
         if (!recv.isRadioOn()) {
@@ -228,7 +264,7 @@ public class MRM extends AbstractRadioMedium {
             recv.interfereAnyReception();
 
             /* Interfere receiver in all other active radio connections */
-            for (RadioConnection conn : getActiveConnections()) {
+            for (RadioConnection conn : getActiveConnectionsTo(recv)) {
               if (conn.isDestination(recv)) {
                 conn.addInterfered(recv);
               }
@@ -251,14 +287,14 @@ public class MRM extends AbstractRadioMedium {
                 recv.interfereAnyReception();
 
                 /* Interfere receiver in all other active radio connections */
-                for (RadioConnection conn : getActiveConnections()) {
+                for (RadioConnection conn : getActiveConnectionsTo(recv)) {
                   if (conn.isDestination(recv)) {
                     conn.addInterfered(recv);
                   }
                 }
               } else {
                 /* XXX Warning: removing destination from other connections */
-                for (RadioConnection conn : getActiveConnections()) {
+                for (RadioConnection conn : getActiveConnectionsTo(recv)) {
                   if (conn.isDestination(recv)) {
                     conn.removeDestination(recv);
                   }
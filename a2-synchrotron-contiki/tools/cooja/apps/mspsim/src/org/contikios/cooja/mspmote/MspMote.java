@@ -218,6 +218,9 @@ public abstract class MspMote extends AbstractEmulatedMote implements Mote, Watc
     this.myCpu = node.getCPU();
     this.myCpu.setMonitorExec(true);
     this.myCpu.setTrace(0); /* TODO Enable */
+    /* Skip timer polling loops, the watchpoints and monitors of Cooja disable it where needed */
+    this.myCpu.setBusyWaitFastForward(
+        Cooja.getExternalToolsSetting("MSPSIM_BUSYWAIT_FAST_FORWARD", "false").equalsIgnoreCase("true"));
     
     LogListener ll = new LogListener() {
       private Logger mlogger = Logger.getLogger("MSPSim");
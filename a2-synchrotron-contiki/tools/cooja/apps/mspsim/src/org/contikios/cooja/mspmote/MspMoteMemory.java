@@ -100,11 +100,13 @@ public class MspMoteMemory implements MemoryInterface {
     }
 
     System.arraycopy(memInts, 0, cpu.memory, (int) address, data.length);
+    cpu.codeChanged();
   }
 
   @Override
   public void clearMemory() {
     Arrays.fill(cpu.memory, 0);
+    cpu.codeChanged();
   }
 
   @Override
@@ -50,6 +50,7 @@ import org.contikios.cooja.MoteInterface;
 import org.contikios.cooja.MoteType;
 import org.contikios.cooja.Simulation;
 import org.contikios.cooja.dialogs.CompileContiki;
+import org.contikios.cooja.dialogs.FirmwareCache;
 import org.contikios.cooja.dialogs.MessageList;
 import org.contikios.cooja.dialogs.MessageContainer;
 import org.contikios.cooja.interfaces.IPAddress;
@@ -137,6 +138,14 @@ public class SkyMoteType extends MspMoteType {
 
     final MessageList compilationOutput = MessageContainer.createMessageList(visAvailable);
 
+    /* Reuse a firmware built earlier from the same commands and sources */
+    FirmwareCache firmwareCache = FirmwareCache.create(
+        getCompileCommands(), getContikiFirmwareFile(),
+        getContikiSourceFile() != null ? getContikiSourceFile().getParentFile() : null);
+    if (firmwareCache != null && firmwareCache.restore()) {
+      return true;
+    }
+
     if (getCompileCommands() != null) {
       /* Handle multiple compilation commands one by one */
       String[] arr = getCompileCommands().split("\n");
@@ -148,7 +157,7 @@ public class SkyMoteType extends MspMoteType {
         try {
           CompileContiki.compile(
               cmd,
-              null,
+              firmwareCache != null ? firmwareCache.getCompilationEnvironment() : null,
               null /* Do not observe output firmware file */,
               getContikiSourceFile().getParentFile(),
               null,
@@ -177,6 +186,10 @@ public class SkyMoteType extends MspMoteType {
       }
     }
 
+    if (firmwareCache != null) {
+      firmwareCache.store();
+    }
+
     if (getContikiFirmwareFile() == null ||
         !getContikiFirmwareFile().exists()) {
       throw new MoteTypeCreationException("Contiki firmware file does not exist: " + getContikiFirmwareFile());
@@ -329,7 +329,41 @@ public class Msp802154BitErrorRadio extends Msp802154Radio {
     }
   }
 
+  /* Send a byte over the air with the bit error rate of the current signal strength */
+  private byte transceiveByte(byte data) {
+    double bitErrorRate = getBitErrorRate(currentSignalStrength);
+    if (bitErrorRate == 0.0) {
+      return data;
+    } else if (bitErrorRate >= 0.5) {
+      return (byte) 0xFF;
+    }
+    /* convert to an unsigned int in order to prettify subsequent operations with bits */
+    int incomingByteAsInt = data;
+    if (incomingByteAsInt < 0) incomingByteAsInt += 256;
+
+    /* a byte consists of 2 symbols; independently transceive each of them */
+    int firstSymbol = transceiveSymbolWithErrors(incomingByteAsInt >> 4, bitErrorRate);
+    int secondSymbol = transceiveSymbolWithErrors(incomingByteAsInt & 0xf, bitErrorRate);
+
+    return (byte)((firstSymbol << 4) + secondSymbol);
+  }
+
+  protected void receiveFrame(byte[] frame) {
+    /* Packet-level: the whole frame sees the signal strength at its length byte */
+    byte[] inputFrame = frame.clone();
+    if (!isInterfered()) {
+      for (int i = 0; i < inputFrame.length; i++) {
+        inputFrame[i] = transceiveByte(inputFrame[i]);
+      }
+    }
+    super.receiveFrame(inputFrame);
+  }
+
   public void receiveCustomData(Object data) {
+    if (data instanceof byte[]) {
+      receiveFrame((byte[]) data);
+      return;
+    }
     if (!(data instanceof Byte)) {
       logger.fatal("Bad custom data: " + data);
       return;
@@ -340,22 +374,7 @@ public class Msp802154BitErrorRadio extends Msp802154Radio {
     if (isInterfered()) {
       inputByte = (byte)0xFF;
     } else {
-      double bitErrorRate = getBitErrorRate(currentSignalStrength);
-      if (bitErrorRate == 0.0) {
-        inputByte = lastIncomingByte;
-      } else if (bitErrorRate >= 0.5) {
-        inputByte = (byte) 0xFF;
-      } else {
-        /* convert to an unsigned int in order to prettify subsequent operations with bits */
-        int incomingByteAsInt = lastIncomingByte;
-        if (incomingByteAsInt < 0) incomingByteAsInt += 256;
-
-        /* a byte consists of 2 symbols; independently transceive each of them */
-        int firstSymbol = transceiveSymbolWithErrors(incomingByteAsInt >> 4, bitErrorRate);
-        int secondSymbol = transceiveSymbolWithErrors(incomingByteAsInt & 0xf, bitErrorRate);
-
-        inputByte = (byte)((firstSymbol << 4) + secondSymbol);
-      }
+      inputByte = transceiveByte(lastIncomingByte);
     }
 
     mote.getSimulation().scheduleEvent(new MspMoteTimeEvent(mote, 0) {
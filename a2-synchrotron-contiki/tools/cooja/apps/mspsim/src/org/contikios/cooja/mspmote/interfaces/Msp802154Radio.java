@@ -30,12 +30,14 @@
 
 package org.contikios.cooja.mspmote.interfaces;
 
+import java.util.Arrays;
 import java.util.Collection;
 
 import org.apache.log4j.Logger;
 import org.jdom.Element;
 
 import org.contikios.cooja.ClassDescription;
+import org.contikios.cooja.Cooja;
 import org.contikios.cooja.Mote;
 import org.contikios.cooja.RadioPacket;
 import org.contikios.cooja.Simulation;
@@ -72,6 +74,17 @@ public class Msp802154Radio extends Radio implements CustomDataRadio {
   protected final MspMote mote;
   protected final Radio802154 radio;
 
+  /**
+   * Packet-level mode: a CC2420 hands over the whole frame to the receiving
+   * CC2420s when its length byte goes on air, instead of one byte at a time.
+   * The receiver still sees every byte at the time it would arrive.
+   * Enabled with the external tools setting MSP802154_PACKET_LEVEL=true,
+   * or per radio with setPacketLevel().
+   */
+  private boolean packetLevel;
+  private byte[] outgoingFrame = null;
+  private boolean incomingFrame = false;
+
   private boolean isInterfered = false;
   private boolean isTransmitting = false;
   private boolean isReceiving = false;
@@ -89,10 +102,13 @@ public class Msp802154Radio extends Radio implements CustomDataRadio {
     if (radio == null) {
       throw new IllegalStateException("Mote is not equipped with an IEEE 802.15.4 radio");
     }
+    packetLevel = radio instanceof CC2420 &&
+        Cooja.getExternalToolsSetting("MSP802154_PACKET_LEVEL", "false").equalsIgnoreCase("true");
 
     radio.addRFListener(new RFListener() {
       int len = 0;
       int expMpduLen = 0;
+      boolean frameForwarded = false;
       byte[] buffer = new byte[127 + 6];
       final private byte[] syncSeq = {0,0,0,0,0x7A};
       
@@ -103,16 +119,26 @@ public class Msp802154Radio extends Radio implements CustomDataRadio {
           isTransmitting = true;
           len = 0;
           expMpduLen = 0;
+          frameForwarded = false;
           setChanged();
           notifyObservers();
           /*logger.debug("----- 802.15.4 TRANSMISSION STARTED -----");*/
         }
 
+        if (packetLevel && len == 5 && isSynchronized) {
+          /* the rest of the frame is sent at once if it is complete in the TXFIFO */
+          outgoingFrame = ((CC2420) radio).getTxFrame();
+          frameForwarded = outgoingFrame != null;
+        }
+
         /* send this byte to all nodes */
         lastOutgoingByte = data;
-        lastEvent = RadioEvent.CUSTOM_DATA_TRANSMITTED;
-        setChanged();
-        notifyObservers();
+        if (!frameForwarded || outgoingFrame != null) {
+          lastEvent = RadioEvent.CUSTOM_DATA_TRANSMITTED;
+          setChanged();
+          notifyObservers();
+          outgoingFrame = null;
+        }
 
         if (len < buffer.length)
           buffer[len] = data;
@@ -174,6 +200,20 @@ public class Msp802154Radio extends Radio implements CustomDataRadio {
   }
 
 
+  /**
+   * Sets the packet-level mode of this radio, e.g. from a test script.
+   * It applies from the next transmitted frame on.
+   *
+   * @param enabled True to hand over whole frames, only used with a CC2420
+   */
+  public void setPacketLevel(boolean enabled) {
+    packetLevel = enabled && radio instanceof CC2420;
+  }
+
+  public boolean isPacketLevel() {
+    return packetLevel;
+  }
+
   private void finishTransmission()
   {
     if (isTransmitting()) {
@@ -238,6 +278,9 @@ public class Msp802154Radio extends Radio implements CustomDataRadio {
 
   /* Custom data radio support */
   public Object getLastCustomDataTransmitted() {
+    if (outgoingFrame != null) {
+      return outgoingFrame;
+    }
     return lastOutgoingByte;
   }
 
@@ -246,6 +289,10 @@ public class Msp802154Radio extends Radio implements CustomDataRadio {
   }
 
   public void receiveCustomData(Object data) {
+    if (data instanceof byte[]) {
+      receiveFrame((byte[]) data);
+      return;
+    }
     if (!(data instanceof Byte)) {
       logger.fatal("Bad custom data: " + data);
       return;
@@ -268,6 +315,55 @@ public class Msp802154Radio extends Radio implements CustomDataRadio {
 
   }
 
+  /**
+   * Packet-level reception of a frame from its length byte on.
+   */
+  protected void receiveFrame(byte[] frame) {
+    final byte[] inputFrame = frame.clone();
+    if (isInterfered()) {
+      Arrays.fill(inputFrame, (byte) 0xFF);
+    }
+
+    if (!(radio instanceof CC2420)) {
+      /* Deliver one byte at a time */
+      long deliveryTime = mote.getSimulation().getSimulationTime();
+      for (final byte b: inputFrame) {
+        mote.getSimulation().scheduleEvent(new MspMoteTimeEvent(mote, 0) {
+          public void execute(long t) {
+            super.execute(t);
+            radio.receivedByte(b);
+            mote.requestImmediateWakeup();
+          }
+        }, deliveryTime);
+        deliveryTime += DELAY_BETWEEN_BYTES;
+      }
+      return;
+    }
+
+    incomingFrame = true;
+    mote.getSimulation().scheduleEvent(new MspMoteTimeEvent(mote, 0) {
+      public void execute(long t) {
+        super.execute(t);
+        ((CC2420) radio).receivedFrame(inputFrame);
+        mote.requestImmediateWakeup();
+      }
+    }, mote.getSimulation().getSimulationTime());
+  }
+
+  private void scheduleFrameEvent(final boolean interfere) {
+    mote.getSimulation().scheduleEvent(new MspMoteTimeEvent(mote, 0) {
+      public void execute(long t) {
+        super.execute(t);
+        if (interfere) {
+          ((CC2420) radio).interfereRxFrame();
+        } else {
+          ((CC2420) radio).endRxFrame();
+        }
+        mote.requestImmediateWakeup();
+      }
+    }, mote.getSimulation().getSimulationTime());
+  }
+
   /* General radio support */
   public boolean isTransmitting() {
     return isTransmitting;
@@ -302,6 +398,11 @@ public class Msp802154Radio extends Radio implements CustomDataRadio {
     /* Deliver packet data */
     isReceiving = false;
     isInterfered = false;
+    if (incomingFrame) {
+      /* bytes that were not on air when the transmission ended are lost */
+      incomingFrame = false;
+      scheduleFrameEvent(false);
+    }
 
     lastEvent = RadioEvent.RECEPTION_FINISHED;
     /*logger.debug("----- 802.15.4 RECEPTION FINISHED -----");*/
@@ -317,6 +418,9 @@ public class Msp802154Radio extends Radio implements CustomDataRadio {
     isInterfered = true;
     isReceiving = false;
     lastIncomingPacket = null;
+    if (incomingFrame) {
+      scheduleFrameEvent(true);
+    }
 
     lastEvent = RadioEvent.RECEPTION_INTERFERED;
     /*logger.debug("----- 802.15.4 RECEPTION INTERFERED -----");*/
@@ -36,6 +36,14 @@ import java.awt.datatransfer.StringSelection;
 import java.awt.event.ActionEvent;
 import java.awt.event.ActionListener;
 import java.awt.event.MouseEvent;
+import java.io.BufferedOutputStream;
+import java.io.BufferedWriter;
+import java.io.DataOutputStream;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.FileWriter;
+import java.io.IOException;
+import java.io.PrintWriter;
 import java.util.ArrayList;
 import java.util.Collection;
 import java.util.Observable;
@@ -67,6 +75,9 @@ import org.contikios.cooja.interfaces.Radio;
  * Tracks radio events to sum up transmission, reception, and radio on times.
  * This plugin can be run without visualization, i.e. from a Contiki test.
  *
+ * The radio state changes of every mote are also recorded, so that the times
+ * can be computed for any interval (e.g. per Chaos round) or exported per window.
+ *
  * @author Fredrik Osterlind, Adam Dunkels
  */
 @ClassDescription("Mote radio duty cycle")
@@ -261,6 +272,47 @@ public class PowerTracker extends VisPlugin {
     return radioStatistics(true, true, false);
   }
 
+  /**
+   * Radio times of all motes per window, as CSV.
+   * Windows start at the oldest recorded radio state change of each mote.
+   *
+   * @param window Window length in us
+   * @return CSV with the columns mote, start, duration, on, tx, rx, interfered (us)
+   */
+  public String windowStatistics(long window) {
+    StringBuilder sb = new StringBuilder();
+    sb.append("mote,start,duration,on,tx,rx,interfered\n");
+    for (MoteTracker mt: moteTrackers) {
+      mt.appendWindowStatistics(sb, window);
+    }
+    return sb.toString();
+  }
+
+  public void exportWindowStatistics(File file, long window) throws IOException {
+    PrintWriter out = new PrintWriter(new BufferedWriter(new FileWriter(file)));
+    try {
+      out.print(windowStatistics(window));
+    } finally {
+      out.close();
+    }
+  }
+
+  /**
+   * Exports the recorded radio state changes.
+   * Per mote: mote ID (int), number of changes (int), then per change
+   * the time in us (long) and the state (byte, see MoteTracker.STATE_*).
+   */
+  public void exportStateChanges(File file) throws IOException {
+    DataOutputStream out = new DataOutputStream(new BufferedOutputStream(new FileOutputStream(file)));
+    try {
+      for (MoteTracker mt: moteTrackers) {
+        mt.writeStateChanges(out);
+      }
+    } finally {
+      out.close();
+    }
+  }
+
   public String radioStatistics(boolean radioHW, boolean radioRXTX, boolean onlyAverage) {
     StringBuilder sb = new StringBuilder();
 
@@ -298,11 +350,25 @@ public class PowerTracker extends VisPlugin {
   }
 
   public static class MoteTracker implements Observer {
+    public static final int STATE_ON = 1;
+    public static final int STATE_TX = 2;
+    public static final int STATE_RX = 4;
+    public static final int STATE_INTERFERED = 8;
+
+    /* Recorded state changes, the oldest are overwritten */
+    private static final int MAX_STATE_CHANGES = 1 << 18;
+
     /* last radio state */
     private boolean radioWasOn;
     private RadioState lastRadioState;
     private long lastUpdateTime;
 
+    /* radio state changes: ring buffer of times and states */
+    private long[] changeTimes = new long[256];
+    private byte[] changeStates = new byte[256];
+    private int changeFirst = 0;
+    private int changeCount = 0;
+
     /* accumulating radio state durations */
     long duration = 0;
     long radioOn = 0;
@@ -330,6 +396,7 @@ public class PowerTracker extends VisPlugin {
         lastRadioState = RadioState.IDLE;
       }
       lastUpdateTime = simulation.getSimulationTime();
+      recordState(lastUpdateTime, getState());
 
       radio.addObserver(this);
     }
@@ -370,6 +437,131 @@ public class PowerTracker extends VisPlugin {
       }
       radioWasOn = radio.isRadioOn();
       lastUpdateTime = now;
+
+      recordState(now, getState());
+    }
+
+    private int getState() {
+      int state = radioWasOn ? STATE_ON : 0;
+      if (lastRadioState == RadioState.TRANSMITTING) {
+        state |= STATE_TX;
+      } else if (lastRadioState == RadioState.RECEIVING) {
+        state |= STATE_RX;
+      } else if (lastRadioState == RadioState.INTERFERED) {
+        state |= STATE_INTERFERED;
+      }
+      return state;
+    }
+
+    /* Only changes are recorded, the radio also notifies about e.g. channel changes */
+    private void recordState(long time, int state) {
+      if (changeCount > 0 && getChangeState(changeCount-1) == state) {
+        return;
+      }
+      if (changeCount == changeTimes.length) {
+        if (changeTimes.length < MAX_STATE_CHANGES) {
+          long[] times = new long[2*changeTimes.length];
+          byte[] states = new byte[2*changeTimes.length];
+          for (int i = 0; i < changeCount; i++) {
+            times[i] = getChangeTime(i);
+            states[i] = (byte) getChangeState(i);
+          }
+          changeTimes = times;
+          changeStates = states;
+          changeFirst = 0;
+        } else {
+          /* Overwrite the oldest change */
+          changeFirst = (changeFirst + 1) % changeTimes.length;
+          changeCount--;
+        }
+      }
+      int pos = (changeFirst + changeCount) % changeTimes.length;
+      changeTimes[pos] = time;
+      changeStates[pos] = (byte) state;
+      changeCount++;
+    }
+
+    private long getChangeTime(int i) {
+      return changeTimes[(changeFirst + i) % changeTimes.length];
+    }
+
+    private int getChangeState(int i) {
+      return changeStates[(changeFirst + i) % changeTimes.length];
+    }
+
+    /**
+     * Radio times in the given interval, computed from the recorded state changes.
+     * The interval is limited to the recorded changes and the current time.
+     *
+     * @param from Start time (us)
+     * @param to End time (us)
+     * @return Durations (us): monitored, on, tx, rx, interfered
+     */
+    public long[] getStatistics(long from, long to) {
+      long[] stats = new long[5];
+      to = Math.min(to, simulation.getSimulationTime());
+      if (changeCount == 0 || from >= to) {
+        return stats;
+      }
+
+      /* Last change at or before the start of the interval */
+      int low = 0;
+      int high = changeCount;
+      while (low < high) {
+        int mid = (low + high) >>> 1;
+        if (getChangeTime(mid) <= from) {
+          low = mid + 1;
+        } else {
+          high = mid;
+        }
+      }
+      int i = Math.max(0, low - 1);
+      from = Math.max(from, getChangeTime(i));
+
+      for (; i < changeCount && from < to; i++) {
+        long end = i+1 < changeCount ? Math.min(to, getChangeTime(i+1)) : to;
+        long t = end - from;
+        int state = getChangeState(i);
+        stats[0] += t;
+        if ((state & STATE_ON) != 0) {
+          stats[1] += t;
+        }
+        if ((state & STATE_TX) != 0) {
+          stats[2] += t;
+        }
+        if ((state & STATE_RX) != 0) {
+          stats[3] += t;
+        }
+        if ((state & STATE_INTERFERED) != 0) {
+          stats[4] += t;
+        }
+        from = end;
+      }
+      return stats;
+    }
+
+    void appendWindowStatistics(StringBuilder sb, long window) {
+      if (changeCount == 0 || window <= 0) {
+        return;
+      }
+      long now = simulation.getSimulationTime();
+      for (long start = getChangeTime(0); start < now; start += window) {
+        long[] stats = getStatistics(start, start + window);
+        sb.append(mote.getID()).append(',').append(start);
+        for (long t: stats) {
+          sb.append(',').append(t);
+        }
+        sb.append('\n');
+      }
+    }
+
+    void writeStateChanges(DataOutputStream out) throws IOException {
+      out.writeInt(mote.getID());
+      out.writeInt(changeCount);
+      for (int i = 0; i < changeCount; i++) {
+        out.writeLong(getChangeTime(i));
+        out.writeByte(getChangeState(i));
+      }
     }
 
     protected void accumulateDuration(long t) {
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2009, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+
+package org.contikios.cooja.dialogs;
+
+import java.io.BufferedReader;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileReader;
+import java.io.FileWriter;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.PrintWriter;
+import java.nio.file.Files;
+import java.nio.file.StandardCopyOption;
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+import java.util.ArrayList;
+import java.util.Map;
+import java.util.Set;
+import java.util.TreeSet;
+
+import org.apache.log4j.Logger;
+
+import org.contikios.cooja.Cooja;
+
+/**
+ * Content-addressed cache of compiled Contiki firmwares.
+ *
+ * Entries are keyed by the SHA-1 of the compilation commands, the firmware
+ * file and the compiler environment (CFLAGS etc.). Each entry holds the
+ * firmware and a manifest with the SHA-1 of every source file the firmware
+ * was built from: the files listed in the dependency files (*.d) of the
+ * object directories, and the Makefiles of the source directory.
+ * Builds run with getCompilationEnvironment(), in which Makefile.include
+ * lists all makefiles of the build (e.g. Makefile.chaos) in
+ * obj_TARGET/makefiles.d, so changed build parameters are detected too.
+ * A cached firmware is only reused if none of these files has changed.
+ *
+ * The cache is enabled by the external tools setting FIRMWARE_CACHE_DIR.
+ *
+ * @see CompileContiki
+ */
+public class FirmwareCache {
+  private static Logger logger = Logger.getLogger(FirmwareCache.class);
+
+  private static final String MANIFEST = "manifest";
+  private static final String[] ENVIRONMENT = { "CFLAGS", "LDFLAGS", "TARGET", "PATH" };
+
+  private final File entry;
+  private final File firmware;
+  private final File directory;
+
+  private FirmwareCache(File entry, File firmware, File directory) {
+    this.entry = entry;
+    this.firmware = firmware;
+    this.directory = directory;
+  }
+
+  /**
+   * @param commands Compilation commands
+   * @param firmware Firmware file produced by the commands
+   * @param directory Directory in which the commands are executed
+   * @return Cache entry, or null if the cache is disabled
+   */
+  public static FirmwareCache create(String commands, File firmware, File directory) {
+    String cacheDir = Cooja.getExternalToolsSetting("FIRMWARE_CACHE_DIR", "");
+    if (cacheDir.trim().isEmpty() || commands == null || firmware == null || directory == null) {
+      return null;
+    }
+
+    MessageDigest md = createDigest();
+    update(md, commands.trim());
+    update(md, firmware.getAbsolutePath());
+    update(md, directory.getAbsolutePath());
+    for (String name: ENVIRONMENT) {
+      update(md, name + "=" + System.getenv(name));
+    }
+    return new FirmwareCache(new File(cacheDir, toHex(md.digest())), firmware, directory);
+  }
+
+  /**
+   * Environment for the compilation commands: the current environment, with
+   * the makefiles of the build listed in obj_TARGET/makefiles.d.
+   *
+   * @return Environment for CompileContiki
+   */
+  public String[] getCompilationEnvironment() {
+    ArrayList<String> env = new ArrayList<String>();
+    for (Map.Entry<String, String> var: System.getenv().entrySet()) {
+      env.add(var.getKey() + "=" + var.getValue());
+    }
+    env.add("MAKEFILES_DEPENDENCY=1");
+    return env.toArray(new String[env.size()]);
+  }
+
+  /**
+   * Copies the cached firmware to the firmware file if all its sources are unchanged.
+   *
+   * @return True if the cached firmware was restored
+   */
+  public boolean restore() {
+    File manifest = new File(entry, MANIFEST);
+    File cached = new File(entry, firmware.getName());
+    if (!manifest.exists() || !cached.exists()) {
+      return false;
+    }
+
+    try (BufferedReader in = new BufferedReader(new FileReader(manifest))) {
+      String line;
+      while ((line = in.readLine()) != null) {
+        int sep = line.indexOf(' ');
+        if (sep < 0) {
+          return false;
+        }
+        File source = new File(line.substring(sep + 1));
+        if (!source.isFile() || !line.substring(0, sep).equals(hashFile(source))) {
+          logger.info("Firmware cache miss, changed source: " + source);
+          return false;
+        }
+      }
+      Files.copy(cached.toPath(), firmware.toPath(), StandardCopyOption.REPLACE_EXISTING);
+    } catch (IOException e) {
+      logger.warn("Firmware cache " + entry + ": " + e.getMessage());
+      return false;
+    }
+
+    logger.info("Firmware cache hit: " + firmware + " from " + entry);
+    return true;
+  }
+
+  /**
+   * Stores the compiled firmware together with the manifest of its sources.
+   */
+  public void store() {
+    if (!firmware.exists()) {
+      return;
+    }
+    Set<File> sources = collectSources();
+    if (sources.isEmpty()) {
+      logger.warn("Firmware cache: no dependency files in " + directory + ", not caching " + firmware);
+      return;
+    }
+
+    try {
+      if (!entry.isDirectory() && !entry.mkdirs()) {
+        throw new IOException("could not create directory");
+      }
+
+      /* Several simulations may store the same entry: write to temporary
+       * files and move them in place, the manifest last */
+      File tmpFirmware = File.createTempFile(firmware.getName(), ".tmp", entry);
+      Files.copy(firmware.toPath(), tmpFirmware.toPath(), StandardCopyOption.REPLACE_EXISTING);
+
+      File tmpManifest = File.createTempFile(MANIFEST, ".tmp", entry);
+      try (PrintWriter out = new PrintWriter(new FileWriter(tmpManifest))) {
+        for (File source: sources) {
+          out.println(hashFile(source) + " " + source.getPath());
+        }
+      }
+
+      Files.move(tmpFirmware.toPath(), new File(entry, firmware.getName()).toPath(),
+          StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+      Files.move(tmpManifest.toPath(), new File(entry, MANIFEST).toPath(),
+          StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+    } catch (IOException e) {
+      logger.warn("Firmware cache: could not store " + firmware + " in " + entry + ": " + e.getMessage());
+      return;
+    }
+    logger.info("Firmware cache: stored " + firmware + " in " + entry);
+  }
+
+  private Set<File> collectSources() {
+    Set<File> sources = new TreeSet<File>();
+
+    File[] objectDirs = directory.listFiles();
+    if (objectDirs == null) {
+      return sources;
+    }
+    for (File objectDir: objectDirs) {
+      if (!objectDir.isDirectory() || !objectDir.getName().startsWith("obj_")) {
+        continue;
+      }
+      File[] depFiles = objectDir.listFiles();
+      if (depFiles == null) {
+        continue;
+      }
+      for (File depFile: depFiles) {
+        if (depFile.getName().endsWith(".d")) {
+          parseDependencies(depFile, sources);
+        }
+      }
+    }
+    if (sources.isEmpty()) {
+      return sources;
+    }
+
+    /* The Makefiles hold the project's CFLAGS */
+    for (File file: objectDirs) {
+      if (file.isFile() && file.getName().startsWith("Makefile")) {
+        sources.add(canonical(file));
+      }
+    }
+    return sources;
+  }
+
+  /* Reads the prerequisites of a make dependency file, e.g. "obj_sky/a.o: a.c a.h \" */
+  private void parseDependencies(File depFile, Set<File> sources) {
+    try (BufferedReader in = new BufferedReader(new FileReader(depFile))) {
+      String line;
+      boolean continued = false;
+      while ((line = in.readLine()) != null) {
+        String deps = line;
+        if (!continued) {
+          int sep = line.indexOf(": ");
+          if (sep < 0) {
+            sep = line.endsWith(":") ? line.length() - 1 : -1;
+          }
+          if (sep < 0) {
+            continue;
+          }
+          deps = line.substring(sep + 1);
+        }
+        continued = deps.endsWith("\\");
+        if (continued) {
+          deps = deps.substring(0, deps.length() - 1);
+        }
+        for (String dep: deps.trim().split("\\s+")) {
+          if (dep.isEmpty()) {
+            continue;
+          }
+          File file = new File(dep);
+          if (!file.isAbsolute()) {
+            file = new File(directory, dep);
+          }
+          sources.add(canonical(file));
+        }
+      }
+    } catch (IOException e) {
+      logger.warn("Firmware cache: could not read " + depFile + ": " + e.getMessage());
+    }
+  }
+
+  private static File canonical(File file) {
+    try {
+      return file.getCanonicalFile();
+    } catch (IOException e) {
+      return file.getAbsoluteFile();
+    }
+  }
+
+  private static String hashFile(File file) throws IOException {
+    MessageDigest md = createDigest();
+    byte[] buf = new byte[8192];
+    try (InputStream in = new FileInputStream(file)) {
+      int n;
+      while ((n = in.read(buf)) > 0) {
+        md.update(buf, 0, n);
+      }
+    }
+    return toHex(md.digest());
+  }
+
+  private static MessageDigest createDigest() {
+    try {
+      return MessageDigest.getInstance("SHA-1");
+    } catch (NoSuchAlgorithmException e) {
+      throw new RuntimeException(e);
+    }
+  }
+
+  private static void update(MessageDigest md, String s) {
+    md.update(s.getBytes());
+    md.update((byte) 0);
+  }
+
+  private static String toHex(byte[] data) {
+    StringBuilder sb = new StringBuilder();
+    for (byte b: data) {
+      sb.append(String.format("%02x", b & 0xff));
+    }
+    return sb.toString();
+  }
+}
@@ -45,6 +45,7 @@ import java.awt.event.KeyAdapter;
 import java.awt.event.KeyEvent;
 import java.awt.event.MouseAdapter;
 import java.awt.event.MouseEvent;
+import java.io.BufferedWriter;
 import java.io.File;
 import java.io.FileWriter;
 import java.io.IOException;
@@ -52,7 +53,9 @@ import java.io.PrintWriter;
 import java.util.ArrayList;
 import java.util.Collection;
 import java.util.Date;
+import java.util.HashMap;
 import java.util.List;
+import java.util.regex.Pattern;
 import java.util.regex.PatternSyntaxException;
 
 import javax.swing.AbstractAction;
@@ -165,7 +168,9 @@ public class LogListener extends VisPlugin implements HasQuickHelp {
   private JCheckBoxMenuItem appendCheckBox;
 
   private static final int UPDATE_INTERVAL = 250;
-  private UpdateAggregator<LogData> logUpdateAggregator = new UpdateAggregator<LogData>(UPDATE_INTERVAL) {
+  /* Log outputs per update before the simulation is delayed */
+  private static final int MAX_PENDING = 8192;
+  private UpdateAggregator<LogData> logUpdateAggregator = new UpdateAggregator<LogData>(UPDATE_INTERVAL, MAX_PENDING) {
     private Runnable scroll = new Runnable() {
       public void run() {
         logTable.scrollRectToVisible(
@@ -181,19 +186,30 @@ public class LogListener extends VisPlugin implements HasQuickHelp {
         }
       }
 
+      /* Only the newest outputs fit into the buffer */
+      int bufferSize = simulation.getEventCentral().getLogOutputBufferSize();
+      if (ls.size() > bufferSize) {
+        ls = ls.subList(ls.size() - bufferSize, ls.size());
+      }
+
+      /* Remove old */
+      int removed = Math.max(0, logs.size() + ls.size() - bufferSize);
+      if (removed > 0) {
+        for (int i = 0; i < removed; i++) {
+          logs.remove(0);
+        }
+        model.fireTableRowsDeleted(0, removed-1);
+      }
+
       /* Add */
       int index = logs.size();
       logs.addAll(ls);
       model.fireTableRowsInserted(index, logs.size()-1);
 
-      /* Remove old */
-      int removed = 0;
-      while (logs.size() > simulation.getEventCentral().getLogOutputBufferSize()) {
-        logs.remove(0);
-        removed++;
-      }
-      if (removed > 0) {
-        model.fireTableRowsDeleted(0, removed-1);
+      /* Appended log outputs are flushed once per update */
+      PrintWriter out = appendStream;
+      if (out != null) {
+        out.flush();
       }
 
       if (isVisible) {
@@ -666,31 +682,11 @@ public class LogListener extends VisPlugin implements HasQuickHelp {
     filterTextField.setText(str);
 
     try {
-    	final RowFilter<Object,Object> regexp;
+      Pattern regexp = null;
       if (str != null && str.length() > 0) {
-      	regexp = RowFilter.regexFilter(str, COLUMN_FROM, COLUMN_DATA, COLUMN_CONCAT);
-      } else {
-      	regexp = null;
+        regexp = Pattern.compile(str);
       }
-    	RowFilter<Object, Object> wrapped = new RowFilter<Object, Object>() {
-    		public boolean include(RowFilter.Entry<? extends Object, ? extends Object> entry) {
-    		  if (regexp != null) {
-    				boolean pass = regexp.include(entry);
-    				if (inverseFilter && pass) {
-    					return false;
-    				} else if (!inverseFilter && !pass) {
-    					return false;
-    				}
-    			}
-    			if (hideDebug) {
-    				if (entry.getStringValue(COLUMN_DATA).startsWith("DEBUG: ")) {
-    					return false;
-    				}
-    			}
-    			return true;
-    		}
-    	};
-      logFilter.setRowFilter(wrapped);
+      logFilter.setRowFilter(new LogFilter(regexp, inverseFilter, hideDebug));
       filterTextField.setBackground(filterTextFieldBackground);
       filterTextField.setToolTipText(null);
     } catch (PatternSyntaxException e) {
@@ -704,11 +700,19 @@ public class LogListener extends VisPlugin implements HasQuickHelp {
   public void trySelectTime(final long time) {
     java.awt.EventQueue.invokeLater(new Runnable() {
       public void run() {
-        for (int i=0; i < logs.size(); i++) {
-          if (logs.get(i).ev.getTime() < time) {
-            continue;
+        /* Logs are ordered by time */
+        int low = 0;
+        int high = logs.size();
+        while (low < high) {
+          int mid = (low + high) >>> 1;
+          if (logs.get(mid).ev.getTime() < time) {
+            low = mid + 1;
+          } else {
+            high = mid;
           }
+        }
 
+        for (int i=low; i < logs.size(); i++) {
           int view = logTable.convertRowIndexToView(i);
           if (view < 0) {
             continue;
@@ -721,14 +725,75 @@ public class LogListener extends VisPlugin implements HasQuickHelp {
     });
   }
 
+  /**
+   * Log filter on the Mote and Message columns and on both concatenated.
+   * The result is cached per log output until the filter changes, so new
+   * log outputs are filtered once. Matches on the Mote column are cached per mote.
+   */
+  private class LogFilter extends RowFilter<TableModel, Integer> {
+    private final Pattern regexp;
+    private final boolean inverse;
+    private final boolean hideDebug;
+    private final HashMap<Integer, Boolean> moteMatches = new HashMap<Integer, Boolean>();
+
+    public LogFilter(Pattern regexp, boolean inverse, boolean hideDebug) {
+      this.regexp = regexp;
+      this.inverse = inverse;
+      this.hideDebug = hideDebug;
+    }
+
+    public boolean include(RowFilter.Entry<? extends TableModel, ? extends Integer> entry) {
+      LogData data = logs.get(entry.getIdentifier());
+      if (data.filter != this) {
+        data.filter = this;
+        data.accepted = accepts(data.ev, data.getID());
+      }
+      return data.accepted;
+    }
+
+    public boolean accepts(LogOutputEvent ev, String id) {
+      String msg = ev.getMessage();
+      if (regexp != null) {
+        boolean pass = matchesMote(ev.getMote().getID(), id)
+            || regexp.matcher(msg).find()
+            || regexp.matcher(id + ' ' + msg).find();
+        if (inverse == pass) {
+          return false;
+        }
+      }
+      if (hideDebug && msg.startsWith("DEBUG: ")) {
+        return false;
+      }
+      return true;
+    }
+
+    private boolean matchesMote(int moteID, String id) {
+      Boolean match = moteMatches.get(moteID);
+      if (match == null) {
+        match = regexp.matcher(id).find();
+        moteMatches.put(moteID, match);
+      }
+      return match;
+    }
+  }
+
   private class LogData {
     public final LogOutputEvent ev;
+    private String id = null;
+
+    /* Cached result of the filter */
+    private LogFilter filter = null;
+    private boolean accepted;
+
     public LogData(LogOutputEvent ev) {
       this.ev = ev;
     }
 
     public String getID() {
-      return "ID:" + ev.getMote().getID();
+      if (id == null) {
+        id = "ID:" + ev.getMote().getID();
+      }
+      return id;
     }
 
     public String getTime() {
@@ -774,7 +839,7 @@ public class LogListener extends VisPlugin implements HasQuickHelp {
       }
 
       try {
-        PrintWriter outStream = new PrintWriter(new FileWriter(saveFile));
+        PrintWriter outStream = new PrintWriter(new BufferedWriter(new FileWriter(saveFile)));
         for(LogData data : logs) {
           outStream.println(
               data.getTime() + "\t" +
@@ -792,7 +857,7 @@ public class LogListener extends VisPlugin implements HasQuickHelp {
   private boolean appendToFile = false;
   private File appendStreamFile = null;
   private boolean appendToFileWroteHeader = false;
-  private PrintWriter appendStream = null;
+  private volatile PrintWriter appendStream = null;
   public boolean appendToFile(File file, String text) {
     /* Close stream */
     if (file == null) {
@@ -810,7 +875,7 @@ public class LogListener extends VisPlugin implements HasQuickHelp {
           appendStream.close();
           appendStream = null;
         }
-        appendStream = new PrintWriter(new FileWriter(file,true));
+        appendStream = new PrintWriter(new BufferedWriter(new FileWriter(file,true)));
         appendStreamFile = file;
         appendToFileWroteHeader = false;
       } catch (Exception ex) {
@@ -825,7 +890,6 @@ public class LogListener extends VisPlugin implements HasQuickHelp {
       appendToFileWroteHeader = true;
     }
     appendStream.print(text);
-    appendStream.flush();
     return true;
   }
 
@@ -1023,38 +1087,11 @@ public class LogListener extends VisPlugin implements HasQuickHelp {
   /* Experimental feature: let other plugins learn if a log output would be filtered or not */
   public boolean filterWouldAccept(LogOutputEvent ev) {
     RowFilter<? super TableModel, ? super Integer> rowFilter = logFilter.getRowFilter();
-    if (rowFilter == null) {
+    if (!(rowFilter instanceof LogFilter)) {
       /* No filter */
       return true;
     }
-
-    final LogData ld = new LogData(ev);
-    RowFilter.Entry<? extends TableModel, ? extends Integer> entry = new RowFilter.Entry<TableModel, Integer>() {
-      public TableModel getModel() {
-        return model;
-      }
-      public int getValueCount() {
-        return model.getColumnCount();
-      }
-      public Object getValue(int index) {
-        if (index == COLUMN_TIME) {
-          return ld.getTime();
-        } else if (index == COLUMN_FROM) {
-          return ld.getID();
-        } else if (index == COLUMN_DATA) {
-          return ld.ev.getMessage();
-        } else if (index == COLUMN_CONCAT) {
-          return ld.getID() + ' ' + ld.ev.getMessage();
-        }
-        return null;
-      }
-      public Integer getIdentifier() {
-        return null;
-      }
-    };
-    boolean show;
-    show = rowFilter.include(entry);
-    return show;
+    return ((LogFilter) rowFilter).accepts(ev, "ID:" + ev.getMote().getID());
   }
   public Color getColorOfEntry(LogOutputEvent logEvent) {
     int color = (10+logEvent.getMote().getID())%10;
@@ -48,7 +48,9 @@ import java.io.File;
 import java.io.FileOutputStream;
 import java.io.OutputStreamWriter;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Collection;
+import java.util.Iterator;
 import java.util.Observable;
 import java.util.Observer;
 
@@ -116,6 +118,16 @@ public class TimeLine extends VisPlugin implements HasQuickHelp {
   private static final boolean PAINT_ZERO_WIDTH_EVENTS = true;
   private static final int TIMELINE_UPDATE_INTERVAL = 100;
 
+  /* Events are stored in chunks, the oldest chunks are dropped above the optional event limit */
+  private static final int EVENT_CHUNK_BITS = 10;
+  private static final int EVENT_CHUNK_SIZE = 1 << EVENT_CHUNK_BITS;
+  private static final int NO_EVENT_LIMIT = 0;
+
+  /* When zoomed out, at most this many events are painted per pixel */
+  private static final int LOD_EVENTS_PER_PIXEL = 4;
+
+  private int eventLimit = NO_EVENT_LIMIT;
+
   private double currentPixelDivisor = 200;
 
   private static final long[] ZOOM_LEVELS = {
@@ -711,6 +723,10 @@ public class TimeLine extends VisPlugin implements HasQuickHelp {
         return;
       }
 
+      if (hasDroppedEvents()) {
+        logger.warn("Event limit (" + eventLimit + ") reached: " + saveFile + " lacks the oldest events");
+      }
+
     }
   };
 
@@ -910,9 +926,25 @@ public class TimeLine extends VisPlugin implements HasQuickHelp {
     average.onTimeInterfered /= allStats.size();
 
     output.append(average.toString(logs, leds, radioHW, radioRXTX));
+
+    if (hasDroppedEvents()) {
+      output.append("Event limit (" + eventLimit + ") reached: the oldest events were dropped, " +
+          "the times above are lower than the actual ones\n");
+    }
     return output.toString();
   }
 
+  private boolean hasDroppedEvents() {
+    for (MoteEvents moteEvents: allMoteEvents) {
+      if (moteEvents.ledEvents.hasDropped() || moteEvents.logEvents.hasDropped() ||
+          moteEvents.radioChannelEvents.hasDropped() || moteEvents.radioHWEvents.hasDropped() ||
+          moteEvents.radioRXTXEvents.hasDropped() || moteEvents.watchpointEvents.hasDropped()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   public void trySelectTime(final long toTime) {
     java.awt.EventQueue.invokeLater(new Runnable() {
       public void run() {
@@ -1333,6 +1365,12 @@ public class TimeLine extends VisPlugin implements HasQuickHelp {
     element.addContent("" + currentPixelDivisor);
     config.add(element);
 
+    if (eventLimit != NO_EVENT_LIMIT) {
+      element = new Element("eventlimit");
+      element.addContent("" + eventLimit);
+      config.add(element);
+    }
+
     return config;
   }
 
@@ -1380,6 +1418,9 @@ public class TimeLine extends VisPlugin implements HasQuickHelp {
         /* NB: Historically no validation on this option */
         final double cpd = Double.parseDouble(element.getText());
         zoomFinish(cpd, 0, 0);
+      } else if ("eventlimit".equals(name)) {
+        int limit = Integer.parseInt(element.getText());
+        eventLimit = limit <= 0 ? NO_EVENT_LIMIT : Math.max(2*EVENT_CHUNK_SIZE, limit);
       }
     }
 
@@ -1641,45 +1682,27 @@ public class TimeLine extends VisPlugin implements HasQuickHelp {
         dark = !dark;
 
         if (showRadioRXTX) {
-          MoteEvent firstEvent = getFirstIntervalEvent(allMoteEvents.get(mIndex).radioRXTXEvents, intervalStart);
-          if (firstEvent != null) {
-            firstEvent.paintInterval(g, lineHeightOffset, intervalEnd);
-          }
+          paintEvents(g, allMoteEvents.get(mIndex).radioRXTXEvents, lineHeightOffset, intervalStart, intervalEnd);
           lineHeightOffset += EVENT_PIXEL_HEIGHT;
         }
         if (showRadioChannels) {
-          MoteEvent firstEvent = getFirstIntervalEvent(allMoteEvents.get(mIndex).radioChannelEvents, intervalStart);
-          if (firstEvent != null) {
-            firstEvent.paintInterval(g, lineHeightOffset, intervalEnd);
-          }
+          paintEvents(g, allMoteEvents.get(mIndex).radioChannelEvents, lineHeightOffset, intervalStart, intervalEnd);
           lineHeightOffset += EVENT_PIXEL_HEIGHT;
         }
         if (showRadioOnoff) {
-          MoteEvent firstEvent = getFirstIntervalEvent(allMoteEvents.get(mIndex).radioHWEvents, intervalStart);
-          if (firstEvent != null) {
-            firstEvent.paintInterval(g, lineHeightOffset, intervalEnd);
-          }
+          paintEvents(g, allMoteEvents.get(mIndex).radioHWEvents, lineHeightOffset, intervalStart, intervalEnd);
           lineHeightOffset += EVENT_PIXEL_HEIGHT;
         }
         if (showLeds) {
-          MoteEvent firstEvent = getFirstIntervalEvent(allMoteEvents.get(mIndex).ledEvents, intervalStart);
-          if (firstEvent != null) {
-            firstEvent.paintInterval(g, lineHeightOffset, intervalEnd);
-          }
+          paintEvents(g, allMoteEvents.get(mIndex).ledEvents, lineHeightOffset, intervalStart, intervalEnd);
           lineHeightOffset += 3*LED_PIXEL_HEIGHT;
         }
         if (showLogOutputs) {
-          MoteEvent firstEvent = getFirstIntervalEvent(allMoteEvents.get(mIndex).logEvents, intervalStart);
-          if (firstEvent != null) {
-            firstEvent.paintInterval(g, lineHeightOffset, intervalEnd);
-          }
+          paintEvents(g, allMoteEvents.get(mIndex).logEvents, lineHeightOffset, intervalStart, intervalEnd);
           lineHeightOffset += EVENT_PIXEL_HEIGHT;
         }
         if (showWatchpoints) {
-          MoteEvent firstEvent = getFirstIntervalEvent(allMoteEvents.get(mIndex).watchpointEvents, intervalStart);
-          if (firstEvent != null) {
-            firstEvent.paintInterval(g, lineHeightOffset, intervalEnd);
-          }
+          paintEvents(g, allMoteEvents.get(mIndex).watchpointEvents, lineHeightOffset, intervalStart, intervalEnd);
           lineHeightOffset += EVENT_PIXEL_HEIGHT;
         }
 
@@ -1690,29 +1713,46 @@ public class TimeLine extends VisPlugin implements HasQuickHelp {
       drawMouseTime(g, intervalStart, intervalEnd);
     }
 
-    private <T extends MoteEvent> T getFirstIntervalEvent(ArrayList<T> events, long time) {
-      /* TODO IMPLEMENT ME: Binary search */
-      int nrEvents = events.size();
-      if (nrEvents == 0) {
+    private MoteEvent getFirstIntervalEvent(EventList events, long time) {
+      int ev = events.getFirstIntervalIndex(time);
+      if (ev < 0) {
         return null;
       }
-      if (nrEvents == 1) {
-        events.get(0);
-      }
+      return events.get(ev);
+    }
 
-      int ev = 0;
-      while (ev < nrEvents && events.get(ev).time < time) {
-        ev++;
+    private void paintEvents(Graphics g, EventList events, int lineHeightOffset, long start, long end) {
+      int first = events.getFirstIntervalIndex(start);
+      MoteEvent firstEvent = events.get(first);
+      if (firstEvent == null) {
+        return;
       }
-      ev--;
-      if (ev < 0) {
-        ev = 0;
+      int firstPixel = (int) (start/currentPixelDivisor);
+      int lastPixel = (int) (end/currentPixelDivisor);
+      if (events.getFirstIntervalIndex(end) - first <= LOD_EVENTS_PER_PIXEL*(lastPixel - firstPixel + 1)) {
+        firstEvent.paintInterval(g, lineHeightOffset, end);
+        return;
       }
 
-      if (ev >= events.size()) {
-        return events.get(events.size()-1);
+      /* Zoomed out: skip to each pixel and paint only its first events */
+      paintEvent(g, firstEvent, lineHeightOffset, end);
+      for (int x = firstPixel; x <= lastPixel; x++) {
+        long pixelStart = (long) (x*currentPixelDivisor);
+        long pixelEnd = Math.min(end, (long) ((x+1)*currentPixelDivisor));
+        int ev = events.getIndexAfter(Math.max(start, pixelStart));
+        for (int i = 0; i < LOD_EVENTS_PER_PIXEL && ev + i < events.size(); i++) {
+          MoteEvent e = events.get(ev + i);
+          if (e == null || e.time >= pixelEnd) {
+            break;
+          }
+          paintEvent(g, e, lineHeightOffset, end);
+        }
       }
-      return events.get(ev);
+    }
+
+    /* Paints a single event, up to the next event */
+    private void paintEvent(Graphics g, MoteEvent ev, int lineHeightOffset, long end) {
+      ev.paintInterval(g, lineHeightOffset, ev.next == null ? end : ev.time + 1);
     }
 
     private void drawTimeRule(Graphics g, long start, long end) {
@@ -1791,7 +1831,7 @@ public class TimeLine extends VisPlugin implements HasQuickHelp {
       tooltip += "Time (ms): " + (double)time/Simulation.MILLISECOND + "<br>";
 
       /* Event */
-      ArrayList<? extends MoteEvent> events = null;
+      EventList events = null;
       int evMatched = 0;
       int evMouse = ((event.getPoint().y-FIRST_MOTE_PIXEL_OFFSET) % paintedMoteHeight) / EVENT_PIXEL_HEIGHT;
       if (showRadioRXTX) {
@@ -2279,14 +2319,111 @@ public class TimeLine extends VisPlugin implements HasQuickHelp {
       }
     }
   }
+
+  /**
+   * Time-ordered events of one mote and event type.
+   *
+   * Events are stored in fixed-size chunks and found by binary search on
+   * their time. If an event limit is configured and exceeded, the oldest
+   * chunk is dropped, so memory use does not grow with the simulated time.
+   */
+  class EventList implements Iterable<MoteEvent> {
+    private final ArrayList<MoteEvent[]> chunks = new ArrayList<MoteEvent[]>();
+    private int size = 0;
+    private boolean dropped = false;
+
+    public synchronized void add(MoteEvent ev) {
+      if (size == chunks.size()*EVENT_CHUNK_SIZE) {
+        chunks.add(new MoteEvent[EVENT_CHUNK_SIZE]);
+      }
+      chunks.get(size >> EVENT_CHUNK_BITS)[size & (EVENT_CHUNK_SIZE-1)] = ev;
+      size++;
+
+      if (eventLimit != NO_EVENT_LIMIT && size > eventLimit && chunks.size() > 1) {
+        chunks.remove(0);
+        size -= EVENT_CHUNK_SIZE;
+        chunks.get(0)[0].prev = null;
+        dropped = true;
+      }
+    }
+
+    /**
+     * @return True if events were dropped due to the event limit
+     */
+    public synchronized boolean hasDropped() {
+      return dropped;
+    }
+
+    /**
+     * @param i Index
+     * @return Event, or null if no longer stored
+     */
+    public synchronized MoteEvent get(int i) {
+      if (i < 0 || i >= size) {
+        return null;
+      }
+      return chunks.get(i >> EVENT_CHUNK_BITS)[i & (EVENT_CHUNK_SIZE-1)];
+    }
+
+    public synchronized int size() {
+      return size;
+    }
+
+    public synchronized void clear() {
+      chunks.clear();
+      size = 0;
+      dropped = false;
+    }
+
+    /**
+     * @param time Time
+     * @return Index of the first event at or after the given time, or size()
+     */
+    public synchronized int getIndexAfter(long time) {
+      int low = 0;
+      int high = size;
+      while (low < high) {
+        int mid = (low + high) >>> 1;
+        if (get(mid).time < time) {
+          low = mid + 1;
+        } else {
+          high = mid;
+        }
+      }
+      return low;
+    }
+
+    /**
+     * @param time Time
+     * @return Index of the last event before the given time (or the first event), -1 if empty
+     */
+    public synchronized int getFirstIntervalIndex(long time) {
+      if (size == 0) {
+        return -1;
+      }
+      return Math.max(0, getIndexAfter(time) - 1);
+    }
+
+    public Iterator<MoteEvent> iterator() {
+      MoteEvent[] events;
+      synchronized (this) {
+        events = new MoteEvent[size];
+        for (int i = 0; i < size; i++) {
+          events[i] = get(i);
+        }
+      }
+      return Arrays.asList(events).iterator();
+    }
+  }
+
   class MoteEvents {
     Mote mote;
-    ArrayList<MoteEvent> radioRXTXEvents;
-    ArrayList<MoteEvent> radioChannelEvents;
-    ArrayList<MoteEvent> radioHWEvents;
-    ArrayList<MoteEvent> ledEvents;
-    ArrayList<MoteEvent> logEvents;
-    ArrayList<MoteEvent> watchpointEvents;
+    EventList radioRXTXEvents;
+    EventList radioChannelEvents;
+    EventList radioHWEvents;
+    EventList ledEvents;
+    EventList logEvents;
+    EventList watchpointEvents;
 
     private MoteEvent lastRadioRXTXEvent = null;
     private MoteEvent lastRadioChannelEvent = null;
@@ -2297,12 +2434,12 @@ public class TimeLine extends VisPlugin implements HasQuickHelp {
 
     public MoteEvents(Mote mote) {
       this.mote = mote;
-      this.radioRXTXEvents = new ArrayList<MoteEvent>();
-      this.radioChannelEvents = new ArrayList<MoteEvent>();
-      this.radioHWEvents = new ArrayList<MoteEvent>();
-      this.ledEvents = new ArrayList<MoteEvent>();
-      this.logEvents = new ArrayList<MoteEvent>();
-      this.watchpointEvents = new ArrayList<MoteEvent>();
+      this.radioRXTXEvents = new EventList();
+      this.radioChannelEvents = new EventList();
+      this.radioHWEvents = new EventList();
+      this.ledEvents = new EventList();
+      this.logEvents = new EventList();
+      this.watchpointEvents = new EventList();
 
       if (mote.getSimulation().getSimulationTime() > 0) {
         /* Create no history events */
@@ -2465,6 +2602,10 @@ public class TimeLine extends VisPlugin implements HasQuickHelp {
         "<p>All motes are by default shown in the timeline. Motes can be removed from the timeline by right-clicking the node ID on the left." +
         "<p>To display a vertical time marker on the timeline, press and hold the mouse on the time ruler (top)." +
         "<p>For more options for a given event, right-click the mouse for a popup menu." +
+        (eventLimit != NO_EVENT_LIMIT ?
+            "<p>Only the latest " + eventLimit + " events per mote and event type are kept. " +
+            "The statistics and saved files then only cover these events. " : "<p>") +
+        "When zoomed out, only the first events of every pixel are painted." +
         "<p><b>Radio traffic</b>" +
         "<br>Shows radio traffic events. Transmissions are painted blue, receptions are green, and interfered radios are red." +
         "<p><b>Radio channel</b>" +
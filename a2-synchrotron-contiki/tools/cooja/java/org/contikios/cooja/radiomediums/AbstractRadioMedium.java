@@ -32,7 +32,9 @@ package org.contikios.cooja.radiomediums;
 
 import java.util.ArrayList;
 import java.util.Collection;
+import java.util.Collections;
 import java.util.HashMap;
+import java.util.List;
 import java.util.Map;
 import java.util.Map.Entry;
 import java.util.Observable;
@@ -83,6 +85,13 @@ public abstract class AbstractRadioMedium extends RadioMedium {
 	
 	private ArrayList<RadioConnection> activeConnections = new ArrayList<RadioConnection>();
 	
+	/* Active connections per source, and per destination or interfered radio.
+	 * A connection may stay indexed for a radio that was removed from it
+	 * until the connection finishes. */
+	private HashMap<Radio, RadioConnection> connectionsFrom = new HashMap<Radio, RadioConnection>();
+	private HashMap<Radio, ArrayList<RadioConnection>> connectionsTo = new HashMap<Radio, ArrayList<RadioConnection>>();
+	private HashMap<RadioConnection, ArrayList<Radio>> indexedRadios = new HashMap<RadioConnection, ArrayList<Radio>>();
+	
 	private RadioConnection lastConnection = null;
 	
 	private Simulation simulation = null;
@@ -124,6 +133,88 @@ public abstract class AbstractRadioMedium extends RadioMedium {
 		return activeConnections.toArray(new RadioConnection[0]);
 	}
 	
+	/**
+	 * Returns the active connections that have the given radio as destination
+	 * or interfered radio. This may include connections the radio was later
+	 * removed from, use RadioConnection.isDestination() to check.
+	 *
+	 * @param radio Radio
+	 * @return Active connections to radio
+	 */
+	public List<RadioConnection> getActiveConnectionsTo(Radio radio) {
+		ArrayList<RadioConnection> conns = connectionsTo.get(radio);
+		if (conns == null) {
+			return Collections.emptyList();
+		}
+		return Collections.unmodifiableList(conns);
+	}
+	
+	/**
+	 * @param source Source radio
+	 * @return Active connection from source, or null
+	 */
+	protected RadioConnection getActiveConnectionFrom(Radio source) {
+		return connectionsFrom.get(source);
+	}
+	
+	/**
+	 * Indexes the destinations and interfered radios of an active connection.
+	 * Radio mediums must call this when they add radios to a connection
+	 * after it was created.
+	 *
+	 * @param conn Active connection
+	 */
+	protected void updateConnectionIndex(RadioConnection conn) {
+		ArrayList<Radio> radios = indexedRadios.get(conn);
+		if (radios == null) {
+			return;
+		}
+		for (Radio radio : conn.getAllDestinations()) {
+			indexConnectionTo(radio, conn, radios);
+		}
+		for (Radio radio : conn.getInterfered()) {
+			indexConnectionTo(radio, conn, radios);
+		}
+	}
+	
+	private void indexConnectionTo(Radio radio, RadioConnection conn, ArrayList<Radio> radios) {
+		if (radios.contains(radio)) {
+			return;
+		}
+		radios.add(radio);
+		ArrayList<RadioConnection> conns = connectionsTo.get(radio);
+		if (conns == null) {
+			conns = new ArrayList<RadioConnection>();
+			connectionsTo.put(radio, conns);
+		}
+		conns.add(conn);
+	}
+	
+	private void addActiveConnection(RadioConnection conn) {
+		activeConnections.add(conn);
+		connectionsFrom.put(conn.getSource(), conn);
+		indexedRadios.put(conn, new ArrayList<Radio>());
+		updateConnectionIndex(conn);
+	}
+	
+	private void removeActiveConnection(RadioConnection conn) {
+		activeConnections.remove(conn);
+		if (connectionsFrom.get(conn.getSource()) == conn) {
+			connectionsFrom.remove(conn.getSource());
+		}
+		ArrayList<Radio> radios = indexedRadios.remove(conn);
+		if (radios == null) {
+			return;
+		}
+		for (Radio radio : radios) {
+			ArrayList<RadioConnection> conns = connectionsTo.get(radio);
+			conns.remove(conn);
+			if (conns.isEmpty()) {
+				connectionsTo.remove(radio);
+			}
+		}
+	}
+	
 	/**
 	 * Creates a new connection from given radio.
 	 *
@@ -134,6 +225,27 @@ public abstract class AbstractRadioMedium extends RadioMedium {
 	 */
 	abstract public RadioConnection createConnections(Radio radio);
 	
+	/**
+	 * Called when the source of a connection finishes transmitting, before
+	 * the connection is removed. Radio mediums that postpone adding the
+	 * destinations of a connection can complete it here.
+	 *
+	 * @param connection Finished connection
+	 */
+	protected void finishConnection(RadioConnection connection) {
+	}
+	
+	/**
+	 * Updates the signal strengths after the given connection started or
+	 * finished. The default implementation updates all radios. Radio mediums
+	 * can override this to only update the radios the connection reaches.
+	 *
+	 * @param connection Started or finished connection
+	 */
+	protected void updateSignalStrengths(RadioConnection connection) {
+		updateSignalStrengths();
+	}
+	
 	/**
 	 * Updates all radio interfaces' signal strengths according to
 	 * the current active connections.
@@ -197,7 +309,7 @@ public abstract class AbstractRadioMedium extends RadioMedium {
 		}
 		
 		/* Set interfered if currently a connection destination */
-		for (RadioConnection conn : activeConnections) {
+		for (RadioConnection conn : getActiveConnectionsTo(radio)) {
 			if (conn.isDestination(radio)) {
 				conn.addInterfered(radio);
 				if (!radio.isInterfered()) {
@@ -207,15 +319,6 @@ public abstract class AbstractRadioMedium extends RadioMedium {
 		}
 	}
 	
-	private RadioConnection getActiveConnectionFrom(Radio source) {
-		for (RadioConnection conn : activeConnections) {
-			if (conn.getSource() == source) {
-				return conn;
-			}
-		}
-		return null;
-	}
-	
 	/**
 	 * This observer is responsible for detecting radio interface events, for example
 	 * new transmissions.
@@ -257,7 +360,7 @@ public abstract class AbstractRadioMedium extends RadioMedium {
 						 * receiving! Ok, but it won't receive the packet
 						 */
 						radio.interfereAnyReception();
-						for (RadioConnection conn : activeConnections) {
+						for (RadioConnection conn : getActiveConnectionsTo(radio)) {
 							if (conn.isDestination(radio)) {
 								conn.addInterfered(radio);
 							}
@@ -265,7 +368,7 @@ public abstract class AbstractRadioMedium extends RadioMedium {
 					}
 					
 					RadioConnection newConnection = createConnections(radio);
-					activeConnections.add(newConnection);
+					addActiveConnection(newConnection);
 					
 					for (Radio r : newConnection.getAllDestinations()) {
 						if (newConnection.getDestinationDelay(r) == 0) {
@@ -282,7 +385,7 @@ public abstract class AbstractRadioMedium extends RadioMedium {
 							
 						}
 					} /* Update signal strengths */
-					updateSignalStrengths();
+					updateSignalStrengths(newConnection);
 					
 					/* Notify observers */
 					lastConnection = null;
@@ -299,7 +402,8 @@ public abstract class AbstractRadioMedium extends RadioMedium {
 						return;
 					}
 					
-					activeConnections.remove(connection);
+					finishConnection(connection);
+					removeActiveConnection(connection);
 					lastConnection = connection;
 					COUNTER_TX++;
 					for (Radio dstRadio : connection.getAllDestinations()) {
@@ -328,7 +432,7 @@ public abstract class AbstractRadioMedium extends RadioMedium {
 					}
 					
 					/* Update signal strengths */
-					updateSignalStrengths();
+					updateSignalStrengths(connection);
 					
 					/* Notify observers */
 					radioTransmissionObservable.setChangedAndNotify();
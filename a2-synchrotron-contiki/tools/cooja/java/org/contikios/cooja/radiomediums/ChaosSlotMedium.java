@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2010, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ */
+package org.contikios.cooja.radiomediums;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.Random;
+
+import org.apache.log4j.Logger;
+import org.jdom.Element;
+
+import org.contikios.cooja.ClassDescription;
+import org.contikios.cooja.RadioConnection;
+import org.contikios.cooja.RadioPacket;
+import org.contikios.cooja.Simulation;
+import org.contikios.cooja.TimeEvent;
+import org.contikios.cooja.interfaces.Radio;
+
+/**
+ * Slot-synchronous radio medium for Chaos and other synchronous transmission
+ * protocols.
+ *
+ * Links are the edges of the Directed Graph Radio Medium, with per-link
+ * reception ratio and signal strength, and are configured the same way.
+ *
+ * All transmissions that start within one slot window of the first
+ * transmission of a slot are concurrent. Their destinations are decided
+ * together when the window ends, or earlier when one of them ends:
+ *  - every link of every transmitter succeeds with its reception ratio,
+ *  - a receiver that hears a single transmitter receives its frame,
+ *  - a receiver that hears identical frames receives the frame
+ *    (constructive interference),
+ *  - a receiver that hears different frames receives the strongest one if
+ *    it exceeds all others by the capture threshold, and else one of the
+ *    frames within the threshold with the capture ratio (capture effect).
+ *    Otherwise the frames collide.
+ * A frame that starts while a receiver is busy with an earlier slot
+ * interferes with it unless it is weaker by the capture threshold.
+ *
+ * Each receiver gets at most one frame per slot and the cost of a slot is
+ * linear in the links of its transmitters. The frames are delivered as
+ * radio packets, so this medium is meant for packet-level radios such as
+ * the Cooja mote radio, not for radios that exchange single bytes.
+ *
+ * @see DirectedGraphMedium
+ */
+@ClassDescription("Chaos Slot Radio Medium")
+public class ChaosSlotMedium extends DirectedGraphMedium {
+  private static Logger logger = Logger.getLogger(ChaosSlotMedium.class);
+
+  private Simulation simulation;
+  private Random random;
+
+  private long SLOT_WINDOW = Simulation.MILLISECOND; /* us */
+  private double CAPTURE_THRESHOLD = 3; /* dB */
+  private double CAPTURE_RATIO = 1.0;
+
+  private long slot = 0;
+  private long slotStart = -1;
+
+  /* Connections of the current slot without destinations yet */
+  private ArrayList<RadioConnection> pendingConnections = new ArrayList<RadioConnection>();
+
+  /* Last frame each receiver locked on to */
+  private Map<Radio, Reception> receptions = new HashMap<Radio, Reception>();
+
+  private TimeEvent resolveEvent = new TimeEvent(0, "chaos slot") {
+    public void execute(long t) {
+      resolvePendingConnections();
+    }
+  };
+
+  public ChaosSlotMedium(Simulation simulation) {
+    super(simulation);
+    this.simulation = simulation;
+    random = simulation.getRandomGenerator();
+  }
+
+  public void removed() {
+    super.removed();
+    resolveEvent.remove();
+  }
+
+  public void unregisterRadioInterface(Radio radio, Simulation sim) {
+    super.unregisterRadioInterface(radio, sim);
+    receptions.remove(radio);
+  }
+
+  public RadioConnection createConnections(Radio source) {
+    long now = simulation.getSimulationTime();
+    if (slotStart < 0 || now >= slotStart + SLOT_WINDOW) {
+      /* New slot */
+      resolvePendingConnections();
+      slot++;
+      slotStart = now;
+    }
+
+    RadioConnection newConn = new RadioConnection(source);
+    pendingConnections.add(newConn);
+    if (!resolveEvent.isScheduled()) {
+      simulation.scheduleEvent(resolveEvent, slotStart + SLOT_WINDOW);
+    }
+    return newConn;
+  }
+
+  protected void finishConnection(RadioConnection connection) {
+    if (pendingConnections.contains(connection)) {
+      resolvePendingConnections();
+    }
+  }
+
+  /**
+   * Decides the destinations of all pending connections of the current slot.
+   */
+  private void resolvePendingConnections() {
+    resolveEvent.remove();
+    if (pendingConnections.isEmpty()) {
+      return;
+    }
+    RadioConnection[] conns = pendingConnections.toArray(new RadioConnection[0]);
+    pendingConnections.clear();
+
+    /* A frame shorter than the slot window has already ended when its
+     * connection finishes, so the transmitters of the slot are its still
+     * active connections rather than the radios transmitting right now */
+    HashSet<Radio> transmitters = new HashSet<Radio>();
+    for (RadioConnection conn: conns) {
+      transmitters.add(conn.getSource());
+    }
+
+    /* Collect the successful links per receiver, in transmission order */
+    Map<Radio, ArrayList<Reception>> candidates = new LinkedHashMap<Radio, ArrayList<Reception>>();
+    for (RadioConnection conn: conns) {
+      Radio source = conn.getSource();
+      if (getActiveConnectionFrom(source) != conn) {
+        continue;
+      }
+      DGRMDestinationRadio[] destinations = getPotentialDestinations(source);
+      if (destinations == null) {
+        continue;
+      }
+      RadioPacket packet = source.getLastPacketTransmitted();
+
+      for (DGRMDestinationRadio dest: destinations) {
+        Radio recv = dest.radio;
+        if (recv == source) {
+          continue;
+        }
+
+        int srcc = source.getChannel();
+        int dstc = recv.getChannel();
+        int edgeChannel = dest.getChannel();
+        if (edgeChannel >= 0 && dstc >= 0 && edgeChannel != dstc) {
+          /* Fail: the edge is configured for a different radio channel */
+          continue;
+        } else if (srcc >= 0 && dstc >= 0 && srcc != dstc) {
+          /* Fail: radios are on different (but configured) channels */
+          conn.addInterfered(recv);
+          continue;
+        } else if (!recv.isRadioOn() || recv.isTransmitting() || transmitters.contains(recv)) {
+          conn.addInterfered(recv);
+          continue;
+        } else if (dest.ratio < 1.0 && random.nextDouble() > dest.ratio) {
+          /* Fail: reception ratio */
+          conn.addInterfered(recv);
+          continue;
+        }
+
+        ArrayList<Reception> list = candidates.get(recv);
+        if (list == null) {
+          list = new ArrayList<Reception>();
+          candidates.put(recv, list);
+        }
+        list.add(new Reception(conn, packet, dest.signal, slot));
+      }
+    }
+
+    for (Map.Entry<Radio, ArrayList<Reception>> entry: candidates.entrySet()) {
+      Radio recv = entry.getKey();
+      ArrayList<Reception> list = entry.getValue();
+
+      Reception current = recv.isReceiving() ? receptions.get(recv) : null;
+      if (recv.isReceiving() && (current == null || current.slot != slot)) {
+        /* Busy with an earlier transmission: interfere unless much weaker */
+        double strongest = strongest(list).signal;
+        if (current != null && strongest < current.signal - CAPTURE_THRESHOLD) {
+          continue;
+        }
+        interfere(recv, list);
+        continue;
+      }
+      if (recv.isInterfered()) {
+        interfere(recv, list);
+        continue;
+      }
+
+      if (current != null) {
+        /* Already locked on to a frame of this slot */
+        list.add(0, current);
+      }
+      Reception winner = select(list);
+      if (winner == null) {
+        if (current == null) {
+          recv.signalReceptionStart();
+        }
+        interfere(recv, list);
+        continue;
+      }
+      if (winner == current) {
+        continue;
+      }
+
+      if (current != null) {
+        current.conn.removeDestination(recv);
+      } else {
+        recv.signalReceptionStart();
+      }
+      winner.conn.addDestination(recv);
+      recv.setReceivedPacket(winner.packet);
+      receptions.put(recv, winner);
+    }
+
+    /* The signal strengths depend on the edges only and are already up to date */
+    for (RadioConnection conn: conns) {
+      updateConnectionIndex(conn);
+    }
+    radioTransmissionObservable.setChangedAndNotify();
+  }
+
+  /**
+   * @param list Frames heard by a receiver
+   * @return Received frame, or null if the frames collide
+   */
+  private Reception select(ArrayList<Reception> list) {
+    Reception strongest = strongest(list);
+    if (list.size() == 1) {
+      return strongest;
+    }
+
+    ArrayList<Reception> contenders = new ArrayList<Reception>();
+    boolean identical = true;
+    for (Reception r: list) {
+      if (r.signal >= strongest.signal - CAPTURE_THRESHOLD) {
+        contenders.add(r);
+        identical = identical && r.packet != null && strongest.packet != null &&
+            Arrays.equals(r.packet.getPacketData(), strongest.packet.getPacketData());
+      }
+    }
+    if (contenders.size() == 1 || identical) {
+      /* Capture or constructive interference */
+      return strongest;
+    }
+    if (random.nextDouble() < CAPTURE_RATIO) {
+      return contenders.get(random.nextInt(contenders.size()));
+    }
+    return null;
+  }
+
+  private static Reception strongest(ArrayList<Reception> list) {
+    Reception strongest = list.get(0);
+    for (Reception r: list) {
+      if (r.signal > strongest.signal) {
+        strongest = r;
+      }
+    }
+    return strongest;
+  }
+
+  private void interfere(Radio recv, ArrayList<Reception> list) {
+    for (Reception r: list) {
+      r.conn.addInterfered(recv);
+    }
+    recv.interfereAnyReception();
+    for (RadioConnection conn: getActiveConnectionsTo(recv)) {
+      if (conn.isDestination(recv)) {
+        conn.addInterfered(recv);
+      }
+    }
+    receptions.remove(recv);
+  }
+
+  public Collection<Element> getConfigXML() {
+    Collection<Element> config = super.getConfigXML();
+    Element element;
+
+    element = new Element("slot_window");
+    element.setText("" + SLOT_WINDOW);
+    config.add(element);
+
+    element = new Element("capture_threshold");
+    element.setText("" + CAPTURE_THRESHOLD);
+    config.add(element);
+
+    element = new Element("capture_ratio");
+    element.setText("" + CAPTURE_RATIO);
+    config.add(element);
+
+    return config;
+  }
+
+  public boolean setConfigXML(Collection<Element> configXML, boolean visAvailable) {
+    super.setConfigXML(configXML, visAvailable);
+    random = simulation.getRandomGenerator();
+
+    for (Element element : configXML) {
+      if (element.getName().equals("slot_window")) {
+        SLOT_WINDOW = Long.parseLong(element.getText());
+      } else if (element.getName().equals("capture_threshold")) {
+        CAPTURE_THRESHOLD = Double.parseDouble(element.getText());
+      } else if (element.getName().equals("capture_ratio")) {
+        CAPTURE_RATIO = Double.parseDouble(element.getText());
+      }
+    }
+    if (SLOT_WINDOW <= 0) {
+      logger.warn("Invalid slot window " + SLOT_WINDOW + ", using 1 ms");
+      SLOT_WINDOW = Simulation.MILLISECOND;
+    }
+    return true;
+  }
+
+  private static class Reception {
+    final RadioConnection conn;
+    final RadioPacket packet;
+    final double signal;
+    final long slot;
+
+    Reception(RadioConnection conn, RadioPacket packet, double signal, long slot) {
+      this.conn = conn;
+      this.packet = packet;
+      this.signal = signal;
+      this.slot = slot;
+    }
+  }
+}
@@ -32,8 +32,8 @@ package org.contikios.cooja.radiomediums;
 
 import java.util.ArrayList;
 import java.util.Collection;
-import java.util.Enumeration;
-import java.util.Hashtable;
+import java.util.HashMap;
+import java.util.LinkedHashSet;
 import java.util.List;
 import java.util.Random;
 
@@ -66,11 +66,17 @@ public class DirectedGraphMedium extends AbstractRadioMedium {
   private Simulation simulation;
   private Random random;
 
-  private ArrayList<Edge> edges = new ArrayList<Edge>();
+  /* All edges in insertion order, and per radio the edges it is source or destination of.
+   * The tables are updated in place when edges are added or removed. */
+  private LinkedHashSet<Edge> edges = new LinkedHashSet<Edge>();
+  private HashMap<Radio,ArrayList<Edge>> radioEdges = new HashMap<Radio,ArrayList<Edge>>();
+  private Edge[] edgesArray = null;
   private boolean edgesDirty = true;
 
-  /* Used for optimizing lookup time */
-  private Hashtable<Radio,DGRMDestinationRadio[]> edgesTable = new Hashtable<Radio,DGRMDestinationRadio[]>();
+  /* Used for optimizing lookup time: per source its destinations, and the
+   * destinations as array, created on demand */
+  private HashMap<Radio,ArrayList<DGRMDestinationRadio>> destinationsTable = new HashMap<Radio,ArrayList<DGRMDestinationRadio>>();
+  private HashMap<Radio,DGRMDestinationRadio[]> edgesTable = new HashMap<Radio,DGRMDestinationRadio[]>();
 
   private boolean WITH_CAPTURE_EFFECT = true;
   private double CAPTURE_EFFECT_PREAMBLE_DURATION = (double) (1000*1000*4*0.5*8/250000); /* 2 bytes, 250kbit/s, us */;
@@ -94,33 +100,93 @@ public class DirectedGraphMedium extends AbstractRadioMedium {
   }
 
   public void addEdge(Edge e) {
-    edges.add(e);
+    synchronized (edges) {
+      if (!edges.add(e)) {
+        return;
+      }
+      edgesArray = null;
+
+      ArrayList<DGRMDestinationRadio> destinations = destinationsTable.get(e.source);
+      if (destinations == null) {
+        destinations = new ArrayList<DGRMDestinationRadio>();
+        destinationsTable.put(e.source, destinations);
+      }
+      destinations.add(e.superDest);
+      edgesTable.remove(e.source);
+
+      addRadioEdge(e.source, e);
+      if (e.superDest.radio != e.source) {
+        addRadioEdge(e.superDest.radio, e);
+      }
+    }
     requestEdgeAnalysis();
 
     radioTransmissionObservable.setChangedAndNotify();
   }
 
   public void removeEdge(Edge edge) {
-    if (!edges.contains(edge)) {
-      logger.fatal("Cannot remove edge: " + edge);
-      return;
+    synchronized (edges) {
+      if (!edges.remove(edge)) {
+        logger.fatal("Cannot remove edge: " + edge);
+        return;
+      }
+      edgesArray = null;
+
+      ArrayList<DGRMDestinationRadio> destinations = destinationsTable.get(edge.source);
+      destinations.remove(edge.superDest);
+      if (destinations.isEmpty()) {
+        destinationsTable.remove(edge.source);
+      }
+      edgesTable.remove(edge.source);
+
+      removeRadioEdge(edge.source, edge);
+      removeRadioEdge(edge.superDest.radio, edge);
     }
-    edges.remove(edge);
     requestEdgeAnalysis();
 
-
     radioTransmissionObservable.setChangedAndNotify();
   }
 
   public void clearEdges() {
-    edges.clear();
+    synchronized (edges) {
+      edges.clear();
+      edgesArray = null;
+      radioEdges.clear();
+      destinationsTable.clear();
+      edgesTable.clear();
+    }
     requestEdgeAnalysis();
 
     radioTransmissionObservable.setChangedAndNotify();
   }
 
   public Edge[] getEdges() {
-    return edges.toArray(new Edge[0]);
+    synchronized (edges) {
+      if (edgesArray == null) {
+        edgesArray = edges.toArray(new Edge[0]);
+      }
+      return edgesArray;
+    }
+  }
+
+  private void addRadioEdge(Radio radio, Edge edge) {
+    ArrayList<Edge> list = radioEdges.get(radio);
+    if (list == null) {
+      list = new ArrayList<Edge>();
+      radioEdges.put(radio, list);
+    }
+    list.add(edge);
+  }
+
+  private void removeRadioEdge(Radio radio, Edge edge) {
+    ArrayList<Edge> list = radioEdges.get(radio);
+    if (list == null) {
+      return;
+    }
+    list.remove(edge);
+    if (list.isEmpty()) {
+      radioEdges.remove(radio);
+    }
   }
 
   /**
@@ -138,11 +204,16 @@ public class DirectedGraphMedium extends AbstractRadioMedium {
   public void unregisterRadioInterface(Radio radio, Simulation sim) {
     super.unregisterRadioInterface(radio, sim);
 
-    for (Edge edge: getEdges()) {
-      if (edge.source == radio || edge.superDest.radio == radio) {
-        removeEdge(edge);
-        requestEdgeAnalysis();
+    Edge[] radioEdgesArray;
+    synchronized (edges) {
+      ArrayList<Edge> list = radioEdges.get(radio);
+      if (list == null) {
+        return;
       }
+      radioEdgesArray = list.toArray(new Edge[0]);
+    }
+    for (Edge edge: radioEdgesArray) {
+      removeEdge(edge);
     }
   }
 
@@ -195,38 +266,71 @@ public class DirectedGraphMedium extends AbstractRadioMedium {
   }
 
 
+  protected void updateSignalStrengths(RadioConnection connection) {
+    /* Only the source and the radios within its reach are affected */
+    Radio source = connection.getSource();
+    updateSignalStrength(source);
+    DGRMDestinationRadio dstRadios[] = getPotentialDestinations(source);
+    if (dstRadios == null) {
+      return;
+    }
+    for (DGRMDestinationRadio dstRadio : dstRadios) {
+      if (dstRadio.radio != source) {
+        updateSignalStrength(dstRadio.radio);
+      }
+    }
+  }
+
   /**
-   * Generates hash table using current edges for efficient lookup.
+   * Sets the signal strength of a single radio, as updateSignalStrengths()
+   * does, from the active connections of the sources with an edge to it.
    */
-  protected void analyzeEdges() {
-    Hashtable<Radio,ArrayList<DGRMDestinationRadio>> listTable =
-      new Hashtable<Radio,ArrayList<DGRMDestinationRadio>>();
+  private void updateSignalStrength(Radio radio) {
+    double signal = getBaseRssi(radio);
+    if (getActiveConnectionFrom(radio) != null && signal < getSendRssi(radio)) {
+      signal = getSendRssi(radio);
+    }
 
-    /* Fill edge hash table with all edges */
-    for (Edge edge: getEdges()) {
-      ArrayList<DGRMDestinationRadio> destRadios;
-      if (!listTable.containsKey(edge.source)) {
-        destRadios = new ArrayList<DGRMDestinationRadio>();
-      } else {
-        destRadios = listTable.get(edge.source);
-      }
+    synchronized (edges) {
+      ArrayList<Edge> list = radioEdges.get(radio);
+      if (list != null) {
+        for (Edge edge : list) {
+          DGRMDestinationRadio dstRadio = edge.superDest;
+          if (dstRadio.radio != radio || getActiveConnectionFrom(edge.source) == null) {
+            continue;
+          }
 
-      destRadios.add(edge.superDest);
-      listTable.put(edge.source, destRadios);
-    }
+          int activeSourceChannel = edge.source.getChannel();
+          int edgeChannel = dstRadio.channel;
+          int activeDstChannel = radio.getChannel();
+          if (activeSourceChannel != -1) {
+            if (edgeChannel != -1 && activeSourceChannel != edgeChannel) {
+              continue;
+            }
+            if (activeDstChannel != -1 && activeSourceChannel != activeDstChannel) {
+              continue;
+            }
+          }
 
-    /* Convert to arrays */
-    Hashtable<Radio,DGRMDestinationRadio[]> arrTable =  new Hashtable<Radio,DGRMDestinationRadio[]>();
-    Enumeration<Radio> sources = listTable.keys();
-    while (sources.hasMoreElements()) {
-      Radio source = sources.nextElement();
-      DGRMDestinationRadio[] arr = listTable.get(source).toArray(new DGRMDestinationRadio[0]);
-      arrTable.put(source, arr);
+          if (signal < dstRadio.signal) {
+            signal = dstRadio.signal;
+          }
+          radio.setLQI(dstRadio.lqi);
+        }
+      }
     }
+    radio.setCurrentSignalStrength(signal);
+  }
 
-    this.edgesTable = arrTable;
+  /**
+   * Called before lookups after the edges have changed. The lookup tables
+   * are kept up to date by addEdge() and removeEdge(), so this only notifies
+   * the radio medium observers. Subclasses may override this to recreate
+   * the edges.
+   */
+  protected void analyzeEdges() {
     edgesDirty = false;
-    
+
     /* Radio Medium changed here so notify Observers */
     radioMediumObservable.setChangedAndNotify();
   }
@@ -242,7 +346,18 @@ public class DirectedGraphMedium extends AbstractRadioMedium {
     if (edgesDirty) {
       analyzeEdges();
     }
-    return edgesTable.get(source);
+    synchronized (edges) {
+      DGRMDestinationRadio[] arr = edgesTable.get(source);
+      if (arr == null) {
+        ArrayList<DGRMDestinationRadio> destinations = destinationsTable.get(source);
+        if (destinations == null) {
+          return null;
+        }
+        arr = destinations.toArray(new DGRMDestinationRadio[0]);
+        edgesTable.put(source, arr);
+      }
+      return arr;
+    }
   }
 
   public RadioConnection createConnections(Radio source) {
@@ -330,14 +445,11 @@ public class DirectedGraphMedium extends AbstractRadioMedium {
            
            // Find connection, that is sending to that radio
            // and mark the destination as interfered
-           for (RadioConnection conn : getActiveConnections()) {
-             for (Radio dstRadio : conn.getDestinations()) {
-               if (dstRadio == dest.radio) {
-                 conn.addInterfered(dest.radio);
-                 break;
-               }
+           for (RadioConnection conn : getActiveConnectionsTo(dest.radio)) {
+             if (conn.isDestination(dest.radio)) {
+               conn.addInterfered(dest.radio);
              }
-           }        
+           }
            continue;
       	} else {
       		final Radio recv = dest.radio;
@@ -359,14 +471,14 @@ public class DirectedGraphMedium extends AbstractRadioMedium {
               recv.interfereAnyReception();
 
               /* Interfere receiver in all other active radio connections */
-              for (RadioConnection conn : getActiveConnections()) {
+              for (RadioConnection conn : getActiveConnectionsTo(recv)) {
                 if (conn.isDestination(recv)) {
                   conn.addInterfered(recv);
                 }
               }
             } else {
               /* XXX Warning: removing destination from other connections */
-              for (RadioConnection conn : getActiveConnections()) {
+              for (RadioConnection conn : getActiveConnectionsTo(recv)) {
                 if (conn.isDestination(recv)) {
                   conn.removeDestination(recv);
                 }
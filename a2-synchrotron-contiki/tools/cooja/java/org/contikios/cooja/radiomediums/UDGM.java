@@ -236,7 +236,7 @@ public class UDGM extends AbstractRadioMedium {
           recv.interfereAnyReception();
 
           /* Interfere receiver in all other active radio connections */
-          for (RadioConnection conn : getActiveConnections()) {
+          for (RadioConnection conn : getActiveConnectionsTo(recv)) {
             if (conn.isDestination(recv)) {
               conn.addInterfered(recv);
             }
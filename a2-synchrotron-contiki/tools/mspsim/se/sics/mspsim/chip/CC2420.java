@@ -316,6 +316,13 @@ public class CC2420 extends Radio802154 implements USARTListener {
   private int txCursor;
   private boolean on;
 
+  /* Packet-level reception, see receivedFrame() */
+  private static final double BYTE_PERIOD = SYMBOL_PERIOD * 2;
+  private static final double RX_FRAME_SLACK = BYTE_PERIOD / 8;
+  private byte[] rxFrame;
+  private int rxFramePos;
+  private double rxFrameStart;
+
   private TimeEvent oscillatorEvent = new TimeEvent(0, "CC2420 OSC") {
     public void execute(long t) {
       status |= STATUS_XOSC16M_STABLE;
@@ -357,6 +364,12 @@ public class CC2420 extends Radio802154 implements USARTListener {
     }
   };
 
+  private TimeEvent rxFrameEvent = new TimeEvent(0, "CC2420 RX Frame") {
+    public void execute(long t) {
+      updateRxFrame(RX_FRAME_SLACK);
+    }
+  };
+
   private TimeEvent symbolEvent = new TimeEvent(0, "CC2420 Symbol") {
     public void execute(long t) {
       switch(stateMachine) {
@@ -717,6 +730,94 @@ public class CC2420 extends Radio802154 implements USARTListener {
       }
   }
 
+  /**
+   * Returns the frame that is being transmitted (length byte, payload and CRC)
+   * if called while its length byte goes on air and the whole frame already
+   * has been written to the TXFIFO, otherwise null.
+   */
+  public byte[] getTxFrame() {
+    if (stateMachine != RadioState.TX_FRAME || txfifoPos != 0 || txfifoFlush) {
+      return null;
+    }
+    int len = memory[RAM_TXFIFO] & 0xff;
+    if (len < 2 || len > 127 || txCursor < len - 1) {
+      return null;
+    }
+    byte[] frame = new byte[len + 1];
+    txCrc.setCRC(0);
+    for (int i = 0; i < len - 1; i++) {
+      frame[i] = (byte) memory[RAM_TXFIFO + i];
+      if (i > 0) {
+        txCrc.addBitrev(memory[RAM_TXFIFO + i] & 0xff);
+      }
+    }
+    frame[len - 1] = (byte) txCrc.getCRCHi();
+    frame[len] = (byte) txCrc.getCRCLow();
+    return frame;
+  }
+
+  /**
+   * Packet-level reception of a frame (length byte, payload and CRC) whose
+   * first byte is on air now. The bytes are passed to receivedByte() at the
+   * time they would have arrived. Only the bytes that can change a pin or
+   * the radio state get their own event, the others are caught up when the
+   * CPU accesses the radio.
+   */
+  public void receivedFrame(byte[] frame) {
+    updateRxFrame(0);
+    rxFrame = frame.clone();
+    rxFramePos = 0;
+    rxFrameStart = cpu.getTimeMillis();
+    updateRxFrame(0);
+  }
+
+  /* Bytes of the frame that are not on air yet are interfered */
+  public void interfereRxFrame() {
+    if (rxFrame != null) {
+      updateRxFrame(0);
+      for (int i = rxFramePos; rxFrame != null && i < rxFrame.length; i++) {
+        rxFrame[i] = (byte) 0xff;
+      }
+    }
+  }
+
+  /* The transmission has ended, bytes of the frame that are not on air yet are lost */
+  public void endRxFrame() {
+    if (rxFrame != null) {
+      updateRxFrame(BYTE_PERIOD / 2);
+      rxFrame = null;
+      rxFrameEvent.remove();
+    }
+  }
+
+  private void updateRxFrame(double slack) {
+    if (rxFrame == null) {
+      return;
+    }
+    double now = cpu.getTimeMillis() + slack;
+    while (rxFrame != null && rxFramePos < rxFrame.length && rxFrameStart + rxFramePos * BYTE_PERIOD <= now) {
+      receivedByte(rxFrame[rxFramePos++]);
+    }
+    scheduleRxFrame();
+  }
+
+  private void scheduleRxFrame() {
+    if (rxFrame == null || rxFramePos >= rxFrame.length) {
+      rxFrame = null;
+      rxFrameEvent.remove();
+      return;
+    }
+    int remaining = rxFrame.length - rxFramePos;
+    int next = rxFramePos;
+    if (stateMachine == RadioState.RX_FRAME && rxFIFO.length() + remaining < 128
+        && (frameRejected || (currentFIFO && currentFIFOP && !decodeAddress))) {
+      /* only the last byte changes the pins */
+      next = rxFrame.length - 1;
+    }
+    double delay = rxFrameStart + next * BYTE_PERIOD - cpu.getTimeMillis();
+    cpu.scheduleTimeEventMillis(rxFrameEvent, delay > 0 ? delay : 0);
+  }
+
   private void setReg(int address, int data) {
       int oldValue = registers[address];
       switch(address){
@@ -766,6 +867,17 @@ public class CC2420 extends Radio802154 implements USARTListener {
   }
 
   public void dataReceived(USARTSource source, int data) {
+    if (rxFrame != null) {
+      /* the CPU has to see all bytes that are on air by now */
+      updateRxFrame(0);
+      spiDataReceived(source, data);
+      scheduleRxFrame();
+    } else {
+      spiDataReceived(source, data);
+    }
+  }
+
+  private void spiDataReceived(USARTSource source, int data) {
     int oldStatus = status;
     if (logLevel > INFO) {
       log("byte received: " + Utils.hex8(data) +
@@ -0,0 +1,289 @@
+/**
+ * Copyright (c) 2007, 2008, 2009, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of MSPSim.
+ *
+ * -----------------------------------------------------------------
+ *
+ * BusyWaitDetector
+ *
+ * Detects tight loops that only poll a timer counter (e.g. the
+ * BUSYWAIT_UNTIL / RTIMER_NOW() loops of Chaos) and skips the
+ * iterations in which the counter would not change.
+ *
+ * While a loop is tracked the detector is installed as the current
+ * memory segment of the CPU and records one iteration:
+ *  - instruction fetches must stay within the loop,
+ *  - IO reads must only be timer counters (TxR),
+ *  - there must be no IO writes and no RAM writes that change memory,
+ *  - the registers must be the same at the start and the end.
+ * Such an iteration leaves the CPU in the state it started in, so the
+ * next iterations behave the same as long as every timer read returns
+ * the same counter value. These iterations are skipped by moving the
+ * cycles forward, bounded by the next event and the cycles the caller
+ * wants to execute, which gives the same state as stepping them.
+ *
+ * Loops whose first iteration does not read a timer are remembered
+ * in a small cache keyed by the loop range and not tracked again.
+ */
+
+package se.sics.mspsim.core;
+
+public class BusyWaitDetector implements Memory {
+
+  private static final int MAX_INSTRUCTIONS = 32;
+  private static final int MAX_READS = 8;
+  /* Keep the skipped window far below one counter period */
+  private static final long MAX_SKIP_CYCLES = 0x8000;
+
+  private static final int CACHE_SIZE = 256;
+
+  private final MSP430Core cpu;
+  private final Memory[] memorySegments;
+  private final Timer[] counterTimers;
+
+  private Memory memory;
+  private boolean installed = false;
+
+  private int loopHead = -1;
+  private int loopEnd = -1;
+  private long iterationStart;
+  private boolean pure;
+  private final int[] registers = new int[16];
+
+  private int instructionCount;
+  private final int[] instructions = new int[MAX_INSTRUCTIONS];
+  private int lastFetch = -1;
+  private boolean lastFetchExtension = false;
+
+  private int readCount;
+  private final Timer[] readTimer = new Timer[MAX_READS];
+  private final int[] readValue = new int[MAX_READS];
+  private final long[] readOffset = new long[MAX_READS];
+
+  /* loops that are known to not poll a timer, (head << 16) | (end - head) */
+  private final long[] noBusyWait = new long[CACHE_SIZE];
+
+  private long skippedCycles;
+
+  BusyWaitDetector(MSP430Core cpu, Memory[] memorySegments, Timer[] counterTimers) {
+    this.cpu = cpu;
+    this.memorySegments = memorySegments;
+    this.counterTimers = counterTimers;
+    java.util.Arrays.fill(noBusyWait, -1);
+  }
+
+  public long getSkippedCycles() {
+    return skippedCycles;
+  }
+
+  public boolean isInstalled() {
+    return installed;
+  }
+
+  public Memory getWrappedMemory() {
+    return memory;
+  }
+
+  /* Called for every taken backward jump from end to head */
+  void loopJump(int head, int end, long maxCycles) {
+    if (installed && head == loopHead && end == loopEnd) {
+      if (pure && readCount > 0 && sameRegisters()) {
+        fastForward(maxCycles);
+      } else if (readCount == 0) {
+        /* does not poll a timer at all */
+        noBusyWait[cacheIndex(head)] = cacheKey(head, end);
+        stop();
+        return;
+      }
+      startIteration();
+      return;
+    }
+
+    if (noBusyWait[cacheIndex(head)] == cacheKey(head, end)) {
+      stop();
+      return;
+    }
+
+    if (!cpu.canInstallBusyWaitDetector()) {
+      stop();
+      return;
+    }
+    if (!installed) {
+      memory = cpu.currentSegment;
+      cpu.currentSegment = this;
+      installed = true;
+    }
+    loopHead = head;
+    loopEnd = end;
+    startIteration();
+  }
+
+  void stop() {
+    if (installed) {
+      if (cpu.currentSegment == this) {
+        cpu.currentSegment = memory;
+      }
+      installed = false;
+    }
+    loopHead = -1;
+    loopEnd = -1;
+  }
+
+  /* Forget the cached loop ranges, e.g. after the flash has been written */
+  void clearCache() {
+    java.util.Arrays.fill(noBusyWait, -1);
+  }
+
+  private static int cacheIndex(int head) {
+    return (head >> 1) & (CACHE_SIZE - 1);
+  }
+
+  private static long cacheKey(int head, int end) {
+    return ((long) head << 16) | (end - head);
+  }
+
+  private void startIteration() {
+    iterationStart = cpu.cycles;
+    pure = true;
+    readCount = 0;
+    instructionCount = 0;
+    lastFetch = -1;
+    lastFetchExtension = false;
+    System.arraycopy(cpu.reg, 0, registers, 0, registers.length);
+  }
+
+  private boolean sameRegisters() {
+    for (int i = 0; i < registers.length; i++) {
+      if (registers[i] != cpu.reg[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  private boolean sameCounters(long iterationCycles, long k) {
+    long start = cpu.cycles + (k - 1) * iterationCycles;
+    for (int i = 0; i < readCount; i++) {
+      if (readTimer[i].peekCounter(start + readOffset[i]) != readValue[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  private void fastForward(long maxCycles) {
+    long iterationCycles = cpu.cycles - iterationStart;
+    if (iterationCycles <= 0 || cpu.hasPendingInterrupt() || !cpu.canInstallBusyWaitDetector()) {
+      return;
+    }
+
+    /* the last skipped instruction has to end before the next event and the requested cycles */
+    long limit = Math.min(cpu.nextEventCycles - 1, cpu.cycles + MAX_SKIP_CYCLES);
+    if (maxCycles >= 0) {
+      limit = Math.min(limit, maxCycles);
+    }
+    long lo = 0;
+    long hi = (limit - cpu.cycles) / iterationCycles;
+
+    /* the counters only count up inside the window, so the matching iterations are a prefix */
+    while (lo < hi) {
+      long mid = (lo + hi + 1) >>> 1;
+      if (sameCounters(iterationCycles, mid)) {
+        lo = mid;
+      } else {
+        hi = mid - 1;
+      }
+    }
+
+    if (lo > 0) {
+      long start = cpu.cycles + (lo - 1) * iterationCycles;
+      cpu.cycles += lo * iterationCycles;
+      skippedCycles += lo * iterationCycles;
+      /* leave the timers as the last skipped reads would have */
+      for (int i = 0; i < readCount; i++) {
+        readTimer[i].syncCounter(start + readOffset[i]);
+      }
+      cpu.busyWaitSkipped(instructions, instructionCount, (int) lo);
+    }
+  }
+
+  @Override
+  public int read(int address, AccessMode mode, AccessType type) throws EmulationException {
+    if (type == AccessType.EXECUTE) {
+      if (address < loopHead || address > loopEnd || instructionCount >= MAX_INSTRUCTIONS) {
+        /* left the loop */
+        int val = memory.read(address, mode, type);
+        stop();
+        return val;
+      }
+      /* the second fetch of an extended instruction is not an instruction of its own */
+      if (!(lastFetchExtension && address == lastFetch + 2)) {
+        instructions[instructionCount++] = address;
+      }
+      int val = memory.read(address, mode, type);
+      lastFetch = address;
+      lastFetchExtension = (val & 0xf800) == 0x1800;
+      return val;
+    }
+
+    if (address < cpu.MAX_MEM_IO && pure) {
+      Timer timer = counterTimers[address];
+      int counter = timer != null && mode != AccessMode.WORD20 ? timer.peekCounter(cpu.cycles) : -1;
+      if (counter < 0 || readCount >= MAX_READS) {
+        pure = false;
+      } else {
+        readTimer[readCount] = timer;
+        readValue[readCount] = counter;
+        readOffset[readCount] = cpu.cycles - iterationStart;
+        readCount++;
+      }
+    }
+    return memory.read(address, mode, type);
+  }
+
+  @Override
+  public void write(int dstAddress, int data, AccessMode mode) throws EmulationException {
+    if (pure) {
+      if (dstAddress < cpu.MAX_MEM_IO || !(memorySegments[dstAddress >> 8] instanceof RAMSegment)
+          || memorySegments[dstAddress >> 8].get(dstAddress, mode) != (data & mode.mask)) {
+        pure = false;
+      }
+    }
+    memory.write(dstAddress, data, mode);
+  }
+
+  @Override
+  public int get(int address, AccessMode mode) {
+    return memory.get(address, mode);
+  }
+
+  @Override
+  public void set(int address, int data, AccessMode mode) {
+    memory.set(address, data, mode);
+  }
+}
@@ -295,6 +295,7 @@ public class Flash extends IOUnit {
       for (int i = area_start; i < area_end; i++) {
 	memory[i] = 0xff;
       }
+      cpu.codeChanged();
       waitFlashProcess(SEGMENT_ERASE_TIME);
       break;
       
@@ -305,6 +306,7 @@ public class Flash extends IOUnit {
       for (int i = main_range.start; i < main_range.end; i++) {
 	memory[i] = 0xff;
       }
+      cpu.codeChanged();
       waitFlashProcess(MASS_ERASE_TIME);
       break;
       
@@ -315,6 +317,7 @@ public class Flash extends IOUnit {
       for (int i = info_range.start; i < main_range.end; i++) {
 	memory[i] = 0xff;
       }
+      cpu.codeChanged();
       waitFlashProcess(MASS_ERASE_TIME);
       break;
     case WRITE_SINGLE:
@@ -347,6 +350,7 @@ public class Flash extends IOUnit {
               memory[address + 3] &= (data >> 24) & 0xff;
           }
       }
+      cpu.codeChanged();
       if (DEBUG) {
         log("Writing $" + Utils.hex20(data) + " to $" + Utils.hex(address, 4) + " (" + dataMode.bytes + " bytes)");
       }
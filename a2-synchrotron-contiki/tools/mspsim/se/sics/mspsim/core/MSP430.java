@@ -326,6 +326,20 @@ public class MSP430 extends MSP430Core {
     return 0;
   }
 
+  @Override
+  protected boolean isInstructionObserved() {
+    return trace != null || debug;
+  }
+
+  @Override
+  protected void busyWaitSkipped(int[] instructions, int count, int iterations) {
+    if (execCounter != null) {
+      for (int i = 0; i < count; i++) {
+        execCounter[instructions[i]] += iterations;
+      }
+    }
+  }
+
   public void setMonitorExec(boolean mon) {
     if (mon) {
       if (execCounter == null) {
@@ -79,6 +79,17 @@ public class MSP430Core extends Chip implements MSP430Constants {
 
   private final Memory memorySegments[];
   Memory currentSegment;
+  private final Memory coreSegment;
+  private final Memory flashSegment;
+
+  // Read instruction and operand words from the flash without the segment dispatch
+  private boolean directFetch = true;
+
+  // Fast-forward of timer polling loops, see BusyWaitDetector
+  private boolean busyWaitFastForward = false;
+  private final Timer[] counterTimers;
+  private final BusyWaitDetector busyWaitDetector;
+  private boolean hasWatchPoints = false;
 
   public long cycles = 0;
   public long cpuCycles = 0;
@@ -155,7 +166,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
             new FlashRange(config.infoMemStart, config.infoMemStart + config.infoMemSize, 128, 64),
             config.flashControllerOffset);
 
-    currentSegment = new Memory() {
+    currentSegment = coreSegment = new Memory() {
         @Override
         public int read(int address, AccessMode mode, AccessType type) throws EmulationException {
             if (address >= MAX_MEM) {
@@ -205,7 +216,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
     int maxSeg = MAX_MEM >> 8;
     Memory ramSegment = new RAMSegment(this);
     RAMOffsetSegment ramMirrorSegment = null;
-    Memory flashSegment = new FlashSegment(this, flash);
+    flashSegment = new FlashSegment(this, flash);
     IOSegment ioSegment = new IOSegment(this, MAX_MEM_IO, voidIO);
     Memory noMemorySegment = new NoMemSegment(this);
     for (int i = 0; i < maxSeg; i++) {
@@ -250,12 +261,15 @@ public class MSP430Core extends Chip implements MSP430Constants {
 
     // first step towards making core configurable
     Timer[] timers = new Timer[config.timerConfig.length];
+    counterTimers = new Timer[MAX_MEM_IO];
     for (int i = 0; i < config.timerConfig.length; i++) {
         Timer t = new Timer(this, memory, config.timerConfig[i]);
         ioSegment.setIORange(config.timerConfig[i].offset, 0x20, t);
         ioSegment.setIORange(config.timerConfig[i].timerIVAddr, 1, t);
+        counterTimers[config.timerConfig[i].offset + Timer.TR] = t;
         timers[i] = t;
     }
+    busyWaitDetector = new BusyWaitDetector(this, memorySegments, counterTimers);
 
     bcs = config.createClockSystem(this, memory, timers);
     ioSegment.setIORange(bcs.getAddressRangeMin(), bcs.getAddressRangeMax() - bcs.getAddressRangeMin() + 1, bcs);
@@ -298,6 +312,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
   }
 
   public synchronized void addGlobalMonitor(MemoryMonitor mon) {
+      busyWaitDetector.stop();
       GlobalWatchedMemory gwm;
       if (currentSegment instanceof GlobalWatchedMemory) {
           gwm = (GlobalWatchedMemory)currentSegment;
@@ -308,6 +323,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
   }
 
   public synchronized void removeGlobalMonitor(MemoryMonitor mon) {
+      busyWaitDetector.stop();
       if (currentSegment instanceof GlobalWatchedMemory) {
           GlobalWatchedMemory gwm = (GlobalWatchedMemory)currentSegment;
           gwm.removeGlobalMonitor(mon);
@@ -322,6 +338,78 @@ public class MSP430Core extends Chip implements MSP430Constants {
     return registry;
   }
 
+  /**
+   * Enables skipping of the iterations of tight timer polling loops
+   * (e.g. BUSYWAIT_UNTIL) in which the polled counter does not change.
+   * The emulated state stays the same as when stepping through them.
+   */
+  public void setBusyWaitFastForward(boolean enabled) {
+      busyWaitFastForward = enabled;
+      if (!enabled) {
+          busyWaitDetector.stop();
+      }
+  }
+
+  public boolean isBusyWaitFastForward() {
+      return busyWaitFastForward;
+  }
+
+  public BusyWaitDetector getBusyWaitDetector() {
+      return busyWaitDetector;
+  }
+
+  boolean canInstallBusyWaitDetector() {
+      if (!busyWaitFastForward || hasWatchPoints || currentSegment instanceof GlobalWatchedMemory
+              || isInstructionObserved()) {
+          return false;
+      }
+      for (int i = 0; i < 16; i++) {
+          if (regReadMonitors[i] != null || regWriteMonitors[i] != null) {
+              return false;
+          }
+      }
+      return true;
+  }
+
+  boolean hasPendingInterrupt() {
+      return interruptsEnabled && servicedInterrupt == -1 && interruptMax >= 0;
+  }
+
+  /* true if something needs to see every executed instruction */
+  protected boolean isInstructionObserved() {
+      return false;
+  }
+
+  /* called after the given instructions were skipped the given number of times */
+  protected void busyWaitSkipped(int[] instructions, int count, int iterations) {
+  }
+
+  /**
+   * Enables reading instruction and operand words directly from the flash.
+   * The segments are still used while the fetches are watched.
+   */
+  public void setDirectFetch(boolean enabled) {
+      directFetch = enabled;
+  }
+
+  public boolean isDirectFetch() {
+      return directFetch;
+  }
+
+  /* must be called when the code has been changed, e.g. loading firmware or writing the flash */
+  public void codeChanged() {
+      busyWaitDetector.clearCache();
+  }
+
+  /* Fetch an instruction or operand word at the given address */
+  private int fetchWord(int address, AccessType type) throws EmulationException {
+      if (directFetch && (address & 1) == 0 && currentSegment == coreSegment && !isFlashBusy
+              && memorySegments[address >> 8] == flashSegment) {
+          return (memory[address] & 0xff) | ((memory[address + 1] & 0xff) << 8);
+      }
+      return currentSegment.read(address, AccessMode.WORD, type);
+  }
+
   public SFR getSFR() {
     return sfr;
   }
@@ -402,6 +490,8 @@ public class MSP430Core extends Chip implements MSP430Constants {
   }
 
   public synchronized void addWatchPoint(int address, MemoryMonitor mon) {
+      busyWaitDetector.stop();
+      hasWatchPoints = true;
       int seg = address >> 8;
       WatchedMemory wm;
       if (memorySegments[seg] instanceof WatchedMemory) {
@@ -1000,7 +1090,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
     }
 
     int pcBefore = pc;
-    instruction = currentSegment.read(pc, AccessMode.WORD, AccessType.EXECUTE);
+    instruction = fetchWord(pc, AccessType.EXECUTE);
     if (isStopping) {
         // Signaled to stop the execution before performing the instruction
         return -2;
@@ -1037,7 +1127,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
 	// length mode.)
 	wordx20 = (instruction & 0x40) == 0;
 
-	instruction = currentSegment.read(pc, AccessMode.WORD, AccessType.EXECUTE);
+	instruction = fetchWord(pc, AccessType.EXECUTE);
         /*System.out.println("*** Extension word!!! " + Utils.hex16(extWord) +
                 "  read the instruction too: " + Utils.hex16(instruction) + " at " + Utils.hex16(pc - 2));*/
     } else {
@@ -1112,7 +1202,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
 	    cycles += 3;
             break;
         case MOVA_ABS2REG:
-            src = currentSegment.read(pc, AccessMode.WORD, AccessType.READ);
+            src = fetchWord(pc, AccessType.READ);
             writeRegister(PC, pc += 2);
             dst = src + (srcData << 16);
             //System.out.println(Utils.hex20(pc) + " MOVA &ABS Reading from $" + getAddressAsString(dst) + " to reg: " + dstData);
@@ -1125,7 +1215,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
 	case MOVA_INDX2REG:
 		/* Read data from address in memory, indexed by source
 		 * register, and place into destination register. */
-		int index = currentSegment.read(pc, AccessMode.WORD, AccessType.READ);
+		int index = fetchWord(pc, AccessType.READ);
 		int indexModifier = readRegister(srcData);
 
 		index = convertTwoComplement16(index);
@@ -1138,7 +1228,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
 		break;
 
 	case MOVA_REG2ABS:
-            dst = currentSegment.read(pc, AccessMode.WORD, AccessType.READ);
+            dst = fetchWord(pc, AccessType.READ);
             writeRegister(PC, pc += 2);
 	    currentSegment.write(dst + (dstData << 16), readRegister(srcData), mode);
             updateStatus = false;
@@ -1148,7 +1238,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
 	case MOVA_REG2INDX:
 		/* Read data from register, write to address in memory,
 		 * indexed by source register. */
-		index = currentSegment.read(pc, AccessMode.WORD, AccessType.READ);
+		index = fetchWord(pc, AccessType.READ);
 		indexModifier = readRegister(dstData);
 
 		index = convertTwoComplement16(index);
@@ -1161,7 +1251,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
 		break;
 
         case MOVA_IMM2REG:
-            src = currentSegment.read(pc, AccessMode.WORD, AccessType.READ);
+            src = fetchWord(pc, AccessType.READ);
             writeRegister(PC, pc += 2);
             dst = src + (srcData << 16);
 //            System.out.println("*** Writing $" + getAddressAsString(dst) + " to reg: " + dstData);
@@ -1177,7 +1267,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
         	// the data is stored in the following word (PC + 2) and
         	// the high 4 bits in the instruction word, which we have
         	// masked out as srcData.
-        	int immData = currentSegment.read(pc, AccessMode.WORD, AccessType.READ) + (srcData << 16);
+        	int immData = fetchWord(pc, AccessType.READ) + (srcData << 16);
         	writeRegister(PC, pc += 2);
         	int dstArg = readRegister(dstData);
         	dst = dstArg + immData;
@@ -1199,7 +1289,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
 	       operand delivers a negative result, or if the subtraction of a positive source
 	       operand from a negative destination operand delivers a positive result, reset
 	       otherwise (no overflow) */
-		immData = currentSegment.read(pc, AccessMode.WORD, AccessType.READ) + (srcData << 16);
+		immData = fetchWord(pc, AccessType.READ) + (srcData << 16);
 		writeRegister(PC, pc += 2);
 		sr = readRegister(SR);
 
@@ -1229,7 +1319,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
 		break;
 	}
         case SUBA_IMM:
-            immData = currentSegment.read(pc, AccessMode.WORD, AccessType.READ) + (srcData << 16);
+            immData = fetchWord(pc, AccessType.READ) + (srcData << 16);
             writeRegister(PC, pc += 2);
 	    dst = readRegister(dstData) - immData;
 	    writeRegister(dstData, dst);
@@ -1404,7 +1494,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
 
               /* what happens if wrapping here??? */
               /* read the index which is from -15 bit - +15 bit. - so extend sign to 20-bit */
-              int index = currentSegment.read(pc, AccessMode.WORD, AccessType.READ);
+              int index = fetchWord(pc, AccessType.READ);
               index = convertTwoComplement16(index);
 
 //              System.out.println("CALLA INDX: Reg = " + Utils.hex20(dst) + " INDX: " +  index);
@@ -1423,7 +1513,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
               sp = readRegister(SP) - 2;
               writeRegister(SP, sp);
 
-              dst = (dstRegister << 16) | currentSegment.read(pc, AccessMode.WORD, AccessType.READ);
+              dst = (dstRegister << 16) | fetchWord(pc, AccessType.READ);
               pc += 2;
               cycles += 5;
               break;
@@ -1441,7 +1531,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
               writeRegister(SP, sp);
 
               /* read the address of where the address to call is */
-              dst = (dstRegister << 16) | currentSegment.read(pc, AccessMode.WORD, AccessType.READ);
+              dst = (dstRegister << 16) | fetchWord(pc, AccessType.READ);
               dst = currentSegment.read(dst, AccessMode.WORD20, AccessType.READ);
               pc += 2;
               cycles += 7;
@@ -1553,7 +1643,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
                      * "The operand address is the sum of the 20-bit CPU register
                      * content and the 20-bit index."
                      */
-                    dstAddress = currentSegment.read(pc, AccessMode.WORD, AccessType.READ);
+                    dstAddress = fetchWord(pc, AccessType.READ);
                     dstAddress += extDst;
                     dstAddress += rval;
                     dstAddress &= 0xfffff;
@@ -1565,7 +1655,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
                        * after the addition of the CPU register Rn and the signed
                        * 16-bit index."
                        */
-                      dstAddress = convertTwoComplement16(currentSegment.read(pc, AccessMode.WORD, AccessType.READ));
+                      dstAddress = convertTwoComplement16(fetchWord(pc, AccessType.READ));
                       dstAddress += rval;
                       dstAddress &= 0xffff;
                     } else {
@@ -1574,7 +1664,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
                        * "The operand may be located in memory in the range Rn +-32
                        * KB, because the index, X, is a signed 16-bit value"
                        */
-                      dstAddress = convertTwoComplement16(currentSegment.read(pc, AccessMode.WORD, AccessType.READ));
+                      dstAddress = convertTwoComplement16(fetchWord(pc, AccessType.READ));
                       dstAddress += rval;
                       dstAddress &= 0xfffff;
                     }
@@ -1791,6 +1881,9 @@ public class MSP430Core extends Chip implements MSP430Constants {
       // Perform the Jump
       if (jump) {
         writeRegister(PC, pc + jmpOffset);
+        if (jmpOffset < 0 && busyWaitFastForward) {
+          busyWaitDetector.loopJump(pc + jmpOffset, pcBefore, maxCycles);
+        }
       }
       updateStatus = false;
       break;
@@ -1851,7 +1944,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
 	     * "The operand address is the sum of the 20-bit CPU register
 	     * content and the 20-bit index."
 	     */
-	    srcAddress = currentSegment.read(pc, AccessMode.WORD, AccessType.READ);
+	    srcAddress = fetchWord(pc, AccessType.READ);
 	    srcAddress += extSrc;
 	    srcAddress += sval;
 	    srcAddress &= 0xfffff;
@@ -1863,7 +1956,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
 	       * after the addition of the CPU register Rn and the signed
 	       * 16-bit index."
 	       */
-	      srcAddress = convertTwoComplement16(currentSegment.read(pc, AccessMode.WORD, AccessType.READ));
+	      srcAddress = convertTwoComplement16(fetchWord(pc, AccessType.READ));
 	      srcAddress += sval;
 	      srcAddress &= 0xffff;
 	    } else {
@@ -1872,7 +1965,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
 	       * "The operand may be located in memory in the range Rn +-32
 	       * KB, because the index, X, is a signed 16-bit value"
 	       */
-	      srcAddress = convertTwoComplement16(currentSegment.read(pc, AccessMode.WORD, AccessType.READ));
+	      srcAddress = convertTwoComplement16(fetchWord(pc, AccessType.READ));
 	      srcAddress += sval;
 	      srcAddress &= 0xfffff;
 	    }
@@ -1895,8 +1988,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
 				src = currentSegment.read(pc, AccessMode.BYTE,
 						AccessType.READ);
 			} else {
-				src = currentSegment.read(pc, AccessMode.WORD,
-						AccessType.READ);
+				src = fetchWord(pc, AccessType.READ);
 			}
 			src += extSrc;
 
@@ -1929,7 +2021,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
 
         if (dstRegister == 2) {
           /* absolute mode */
-          dstAddress = currentSegment.read(pc, AccessMode.WORD, AccessType.READ); //memory[pc] + (memory[pc + 1] << 8);
+          dstAddress = fetchWord(pc, AccessType.READ); //memory[pc] + (memory[pc + 1] << 8);
           dstAddress += extDst;
         } else {
           // CG here - probably not!???
@@ -1945,7 +2037,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
              * "The operand address is the sum of the 20-bit CPU register
              * content and the 20-bit index."
              */
-            dstAddress = currentSegment.read(pc, AccessMode.WORD, AccessType.READ);
+            dstAddress = fetchWord(pc, AccessType.READ);
             dstAddress += extDst;
             dstAddress += rval;
             dstAddress &= 0xfffff;
@@ -1957,7 +2049,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
                * after the addition of the CPU register Rn and the signed
                * 16-bit index."
                */
-              dstAddress = convertTwoComplement16(currentSegment.read(pc, AccessMode.WORD, AccessType.READ));
+              dstAddress = convertTwoComplement16(fetchWord(pc, AccessType.READ));
               dstAddress += rval;
               dstAddress &= 0xffff;
             } else {
@@ -1966,7 +2058,7 @@ public class MSP430Core extends Chip implements MSP430Constants {
                * "The operand may be located in memory in the range Rn +-32
                * KB, because the index, X, is a signed 16-bit value"
                */
-              dstAddress = convertTwoComplement16(currentSegment.read(pc, AccessMode.WORD, AccessType.READ));
+              dstAddress = convertTwoComplement16(fetchWord(pc, AccessType.READ));
               dstAddress += rval;
               dstAddress &= 0xfffff;
             }
@@ -2205,6 +2297,9 @@ public class MSP430Core extends Chip implements MSP430Constants {
   }
 
   public Memory getMemory() {
+      if (currentSegment == busyWaitDetector) {
+          return busyWaitDetector.getWrappedMemory();
+      }
       return currentSegment;
   }
 
@@ -836,6 +836,29 @@ public class Timer extends IOUnit {
     resetCounter(cycles);
   }
 
+  /* The counter at the given cycles without changing the timer state.
+   * Only for a continuous count, -1 otherwise (see BusyWaitDetector). */
+  int peekCounter(long cycles) {
+    if (mode != CONTIN) return -1;
+
+    double divider = 1;
+    if (clockSource == SRC_ACLK) {
+      divider = 1.0 * cpu.smclkFrq / cpu.aclkFrq;
+    }
+    divider = divider * inputDivider;
+    if (divider < 1) return -1;
+
+    long cycctr = cycles - counterStart;
+    double tick = cycctr / divider;
+    long bigCounter = (long) (tick + counterAcc);
+    return (int) (bigCounter & 0xffff);
+  }
+
+  /* Update the counter as a read at the given cycles would */
+  void syncCounter(long cycles) {
+    updateCounter(cycles);
+  }
+
   private int updateCounter(long cycles) {
     if (mode == STOP) return counter;
     
@@ -141,6 +141,7 @@ public abstract class GenericNode extends Chip implements Runnable {
       int[] memory = cpu.memory;
       IHexReader reader = new IHexReader();
       reader.readFile(memory, firmwareFile);
+      cpu.codeChanged();
     } else {
       loadFirmware(firmwareFile);
     }
@@ -332,6 +333,7 @@ public abstract class GenericNode extends Chip implements Runnable {
     }
     this.elf = elf;
     elf.loadPrograms(memory);
+    cpu.codeChanged();
     MapTable map = elf.getMap();
     cpu.getDisAsm().setMap(map);
     cpu.setMap(map);
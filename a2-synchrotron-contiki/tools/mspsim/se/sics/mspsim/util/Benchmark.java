@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of MSPSim.
+ *
+ * -----------------------------------------------------------------
+ *
+ * Benchmark
+ *
+ * Runs a Tmote Sky firmware for a fixed simulated time, stepping the
+ * CPU the same way as Cooja does, and reports the emulation speed.
+ *
+ * Usage: Benchmark <firmware> [seconds] [-nodirect] [-busywait]
+ */
+package se.sics.mspsim.util;
+import java.io.IOException;
+
+import se.sics.mspsim.cli.CommandHandler;
+import se.sics.mspsim.core.EmulationException;
+import se.sics.mspsim.core.MSP430;
+import se.sics.mspsim.platform.sky.SkyNode;
+
+public class Benchmark {
+
+  /* Cooja steps the motes in one millisecond slots */
+  private static final long STEP_MICROS = 1000;
+
+  public static void main(String[] args) throws IOException, EmulationException {
+    if (args.length < 1) {
+      System.err.println("Usage: " + Benchmark.class.getName() + " <firmware> [seconds] [-nodirect] [-busywait]");
+      System.exit(1);
+    }
+    String firmwareFile = args[0];
+    long seconds = 10;
+    boolean directFetch = true;
+    boolean busyWait = false;
+    for (int i = 1; i < args.length; i++) {
+      if ("-nodirect".equals(args[i])) {
+        directFetch = false;
+      } else if ("-busywait".equals(args[i])) {
+        busyWait = true;
+      } else {
+        seconds = Long.parseLong(args[i]);
+      }
+    }
+
+    SkyNode node = new SkyNode();
+    node.setCommandHandler(new CommandHandler(System.out, System.err));
+    node.setup(new ConfigManager());
+    node.loadFirmware(firmwareFile);
+    MSP430 cpu = node.getCPU();
+    cpu.setDirectFetch(directFetch);
+    cpu.setBusyWaitFastForward(busyWait);
+    cpu.reset();
+
+    long start = System.nanoTime();
+    long micros = 0;
+    long end = seconds * 1000000;
+    while (micros < end) {
+      cpu.stepMicros(micros == 0 ? 0 : STEP_MICROS, STEP_MICROS);
+      micros += STEP_MICROS;
+    }
+    long elapsed = System.nanoTime() - start;
+
+    long instructions = 0;
+    for (int address = 0; address < cpu.MAX_MEM; address++) {
+      instructions += cpu.getExecCount(address);
+    }
+    double wallSeconds = elapsed / 1e9;
+    System.out.println("Firmware:        " + firmwareFile);
+    System.out.println("Simulated time:  " + seconds + " s");
+    System.out.println("Wall time:       " + String.format("%.3f s", wallSeconds));
+    System.out.println("Speed:           " + String.format("%.1f x real time", seconds / wallSeconds));
+    System.out.println("Instructions:    " + instructions);
+    System.out.println("MIPS:            " + String.format("%.2f", instructions / wallSeconds / 1e6));
+    System.out.println("CPU cycles:      " + cpu.cpuCycles);
+    if (busyWait) {
+      System.out.println("Skipped cycles:  " + cpu.getBusyWaitDetector().getSkippedCycles());
+    }
+    System.exit(0);
+  }
+
+}
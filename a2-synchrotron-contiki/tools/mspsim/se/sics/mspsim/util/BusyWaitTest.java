@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * This file is part of MSPSim.
+ *
+ * -----------------------------------------------------------------
+ *
+ * BusyWaitTest
+ *
+ * Runs a Tmote Sky firmware twice for the same simulated time, with the
+ * busy-wait fast-forward off and on, and fails unless both runs execute
+ * the same CPU cycles and instructions and write the same serial output.
+ * Reports the speedup of the fast-forward.
+ *
+ * Usage: BusyWaitTest <firmware> [seconds]
+ */
+package se.sics.mspsim.util;
+import java.io.IOException;
+
+import se.sics.mspsim.cli.CommandHandler;
+import se.sics.mspsim.core.EmulationException;
+import se.sics.mspsim.core.MSP430;
+import se.sics.mspsim.core.USART;
+import se.sics.mspsim.core.USARTListener;
+import se.sics.mspsim.core.USARTSource;
+import se.sics.mspsim.platform.sky.SkyNode;
+
+public class BusyWaitTest {
+
+  /* Cooja steps the motes in one millisecond slots */
+  private static final long STEP_MICROS = 1000;
+
+  private static class Run implements USARTListener {
+    private final StringBuilder output = new StringBuilder();
+    private long cpuCycles;
+    private long instructions;
+    private long skippedCycles;
+    private double wallSeconds;
+
+    public void dataReceived(USARTSource source, int data) {
+      output.append((char) data);
+    }
+  }
+
+  private static Run run(String firmwareFile, long seconds, boolean busyWait)
+      throws IOException, EmulationException {
+    Run run = new Run();
+    SkyNode node = new SkyNode();
+    node.setCommandHandler(new CommandHandler(System.out, System.err));
+    node.setup(new ConfigManager());
+    node.loadFirmware(firmwareFile);
+    MSP430 cpu = node.getCPU();
+    USART usart = cpu.getIOUnit(USART.class, "USART1");
+    if (usart != null) {
+      usart.addUSARTListener(run);
+    }
+    cpu.setBusyWaitFastForward(busyWait);
+    cpu.reset();
+
+    long start = System.nanoTime();
+    long micros = 0;
+    long end = seconds * 1000000;
+    while (micros < end) {
+      cpu.stepMicros(micros == 0 ? 0 : STEP_MICROS, STEP_MICROS);
+      micros += STEP_MICROS;
+    }
+    run.wallSeconds = (System.nanoTime() - start) / 1e9;
+
+    for (int address = 0; address < cpu.MAX_MEM; address++) {
+      run.instructions += cpu.getExecCount(address);
+    }
+    run.cpuCycles = cpu.cpuCycles;
+    run.skippedCycles = cpu.getBusyWaitDetector().getSkippedCycles();
+    return run;
+  }
+
+  public static void main(String[] args) throws IOException, EmulationException {
+    if (args.length < 1) {
+      System.err.println("Usage: " + BusyWaitTest.class.getName() + " <firmware> [seconds]");
+      System.exit(1);
+    }
+    String firmwareFile = args[0];
+    long seconds = args.length > 1 ? Long.parseLong(args[1]) : 10;
+
+    Run off = run(firmwareFile, seconds, false);
+    Run on = run(firmwareFile, seconds, true);
+
+    System.out.println("Firmware:        " + firmwareFile);
+    System.out.println("Simulated time:  " + seconds + " s");
+    System.out.println("CPU cycles:      " + off.cpuCycles + " / " + on.cpuCycles);
+    System.out.println("Instructions:    " + off.instructions + " / " + on.instructions);
+    System.out.println("Serial output:   " + off.output.length() + " / " + on.output.length() + " bytes");
+    System.out.println("Skipped cycles:  " + on.skippedCycles);
+    System.out.println("Wall time:       " + String.format("%.3f s / %.3f s", off.wallSeconds, on.wallSeconds));
+    System.out.println("Speedup:         " + String.format("%.2f", off.wallSeconds / on.wallSeconds));
+
+    boolean ok = true;
+    if (off.cpuCycles != on.cpuCycles || off.instructions != on.instructions) {
+      System.out.println("FAIL: the fast-forward changed the executed cycles or instructions");
+      ok = false;
+    }
+    if (!off.output.toString().equals(on.output.toString())) {
+      System.out.println("FAIL: the fast-forward changed the serial output");
+      System.out.println("#off|" + off.output.toString().replace("\n", "\n#off|"));
+      System.out.println("#on |" + on.output.toString().replace("\n", "\n#on |"));
+      ok = false;
+    }
+    if (on.skippedCycles == 0) {
+      System.out.println("WARNING: no busy-wait was fast-forwarded");
+    }
+    if (ok) {
+      System.out.println("Tests succeded!");
+    }
+    System.exit(ok ? 0 : 1);
+  }
+
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2007, Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the Institute nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE INSTITUTE AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE INSTITUTE OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * -----------------------------------------------------------------
+ *
+ * Busy-wait test: polls Timer A in tight loops, the way Contiki's
+ * rtimer and clock busy-waits do, while a compare interrupt keeps
+ * firing. Run by se.sics.mspsim.util.BusyWaitTest with the busy-wait
+ * fast-forward off and on; the output must be the same.
+ */
+
+#include "msp430setup.h"
+#include <stdio.h>
+#if __MSPGCC__
+#include <msp430.h>
+#include <legacymsp430.h>
+#else /* __MSPGCC__ */
+#include <signal.h>
+#include <io.h>
+#endif /* __MSPGCC__ */
+
+#define INTERVAL 100
+
+static volatile unsigned int ticks = 0;
+
+interrupt(TIMERA0_VECTOR) timera0 (void) {
+  ticks++;
+  TACCR0 += INTERVAL;
+}
+
+static void
+wait_tar(unsigned int t)
+{
+  unsigned int start = TAR;
+  while((unsigned int)(TAR - start) < t);
+}
+
+int
+main(void)
+{
+  int i;
+
+  msp430_setup();
+
+  dint();
+  /* Timer A on ACLK 32768Hz, continuous mode */
+  TACTL = TASSEL0 | TACLR;
+  TACCTL0 = CCIE;
+  TACCR0 = INTERVAL;
+  TACTL |= MC1;
+  eint();
+
+  for(i = 0; i < 20; i++) {
+    wait_tar(1000 + i * 37);
+    printf("wait %d: tar %u ticks %u\n", i, TAR, ticks);
+  }
+
+  /* polling with the interrupts off */
+  dint();
+  wait_tar(5000);
+  printf("dint: tar %u ticks %u\n", TAR, ticks);
+  eint();
+
+  printf("EXIT\n");
+  while(1);
+  return 0;
+}
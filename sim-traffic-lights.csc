@@ -73,6 +73,7 @@
       <network_width value="1" />
       <network_height value="1" />
       <intersection_type value="1" />
+      <traffic_light_control value="1" />
       <timeout value="0" />
     </plugin_config>
     <width>150</width>